@@ -55,8 +55,7 @@
 #include "cr_stack.h"
 #include "i3_log.h"
 #include "reach_silabs.h"
-
-#include "nvm3_default.h"
+#include "param_nvm.h"
 
 #ifdef INCLUDE_COMMAND_SERVICE
 //*************************************************************************
@@ -80,7 +79,7 @@ const cr_CommandInfo sCommands[NUM_COMMANDS] =
   #endif  // def INCLUDE_CLI_SERVICE
     {COMMAND_MIN_LOG,       "Minimize Logging (lm 0)"},
     {COMMAND_MAX_LOG,       "Much Logging (lm 7C0)"},
-    {COMMAND_FACTORY,       "Factory Reset"}     // erases NVM, restores serial number
+    {COMMAND_FACTORY,       "Factory Reset"}     // restores parameter defaults, keeps serial number
 
     //    {47, "Trigger OTA"},        // example not implemented here.
     //    {99, "Board Reset"},        // example not implemented here.
@@ -142,18 +141,16 @@ int crcb_command_execute(const uint8_t cid)
                 break;
             case COMMAND_FACTORY:
             {
-                unsigned int sn;
-                int has_sn = !rsl_read_serial_number(&sn);
-                Ecode_t eCode = nvm3_eraseAll(nvm3_defaultHandle);
-                i3_log(LOG_MASK_ALWAYS, "nvm3_eraseAll() returned 0x%x", eCode);
+                // Old records are abandoned rather than erased, so this
+                // returns quickly.  param_nvm_idle() rewrites them later.
                 extern void init_param_repo();
-                eCode = nvm3_eraseAll(nvm3_defaultHandle);
-                i3_log(LOG_MASK_ALWAYS, "nvm3_eraseAll() returned 0x%x", eCode);
+                int rval = param_nvm_factory_reset();
+                if (rval != 0)
+                    return rval;
                 init_param_repo();
-                if (has_sn) {
-                    nvm3_writeData(nvm3_defaultHandle, REACH_SN_KEY, (uint8_t *)&sn, sizeof(unsigned int));
-                    i3_log(LOG_MASK_ALWAYS, "Serial number restored as %d.", sn);
-                }
+                // Every value may have changed, so a client's journal 
+                // sequence must lead to a full read.
+                cr_parameter_journal_restart(0);
                 break;
             }
             default:
@@ -57,6 +57,27 @@
 
     #include "cr_stack.h"
     #include "i3_log.h"
+  #ifdef INCLUDE_PARAM_HISTORY
+    #include "param_history.h"
+    #define NUM_HISTORY_FILES   1
+  #else
+    #define NUM_HISTORY_FILES   0
+  #endif  // def INCLUDE_PARAM_HISTORY
+  #ifdef INCLUDE_PARAM_SNAPSHOT
+    #include "param_snapshot.h"
+    #define NUM_SNAPSHOT_FILES  1
+  #else
+    #define NUM_SNAPSHOT_FILES  0
+  #endif  // def INCLUDE_PARAM_SNAPSHOT
+  #ifdef INCLUDE_PARAM_DB
+    #include "param_db.h"
+    #define NUM_DB_FILES        1
+  #else
+    #define NUM_DB_FILES        0
+  #endif  // def INCLUDE_PARAM_DB
+
+    // Files generated on demand follow the static files in discovery.
+    #define NUM_VIRTUAL_FILES   (NUM_HISTORY_FILES + NUM_SNAPSHOT_FILES + NUM_DB_FILES)
 
     #define NUM_FILES   2
     static const cr_FileInfo sFiles[NUM_FILES] =
@@ -79,8 +100,63 @@
 
     static int sCrFileLineNum = 0;
 
+    // Describes the generated files in discovery order.
+    static int get_virtual_file_description(int index, cr_FileInfo *file_desc)
+    {
+      #ifdef INCLUDE_PARAM_HISTORY
+        if (index-- == 0)
+        {
+            param_history_get_description(file_desc);
+            return 0;
+        }
+      #endif  // def INCLUDE_PARAM_HISTORY
+      #ifdef INCLUDE_PARAM_SNAPSHOT
+        if (index-- == 0)
+        {
+            param_snapshot_get_description(file_desc);
+            return 0;
+        }
+      #endif  // def INCLUDE_PARAM_SNAPSHOT
+      #ifdef INCLUDE_PARAM_DB
+        if (index-- == 0)
+        {
+            param_db_get_description(file_desc);
+            return 0;
+        }
+      #endif  // def INCLUDE_PARAM_DB
+        (void)index;
+        (void)file_desc;
+        return cr_ErrorCodes_BAD_FILE;
+    }
+
     int crcb_file_get_description(uint32_t fid, cr_FileInfo *file_desc)
     {
+      #ifdef INCLUDE_PARAM_HISTORY
+        if (fid == PARAM_HISTORY_FILE_ID)
+        {
+            // A transfer is starting.  Hold the content so the size stays valid.
+            // The content already held for an active reader is kept.
+            param_history_freeze(cr_get_current_ticks());
+            param_history_get_description(file_desc);
+            return 0;
+        }
+      #endif  // def INCLUDE_PARAM_HISTORY
+      #ifdef INCLUDE_PARAM_SNAPSHOT
+        if (fid == PARAM_SNAPSHOT_FILE_ID)
+        {
+            // A transfer is starting.  Take the snapshot that it will read.
+            param_snapshot_take(cr_get_current_ticks());
+            param_snapshot_get_description(file_desc);
+            return 0;
+        }
+      #endif  // def INCLUDE_PARAM_SNAPSHOT
+      #ifdef INCLUDE_PARAM_DB
+        if (fid == PARAM_DB_FILE_ID)
+        {
+            param_db_get_description(file_desc);
+            return 0;
+        }
+      #endif  // def INCLUDE_PARAM_DB
         if (fid == sFiles[0].file_id)
         {
             *file_desc = sFiles[0];
@@ -110,7 +186,7 @@
 
     int crcb_file_get_file_count()
     {
-        return NUM_FILES;
+        return NUM_FILES + NUM_VIRTUAL_FILES;
     }
 
     static uint8_t sFid_index = 0;
@@ -126,6 +202,27 @@
             sFid_index = 1;
             return 0;
         }
+      #ifdef INCLUDE_PARAM_HISTORY
+        if (fid == PARAM_HISTORY_FILE_ID)
+        {
+            sFid_index = NUM_FILES;
+            return 0;
+        }
+      #endif  // def INCLUDE_PARAM_HISTORY
+      #ifdef INCLUDE_PARAM_SNAPSHOT
+        if (fid == PARAM_SNAPSHOT_FILE_ID)
+        {
+            sFid_index = NUM_FILES + NUM_HISTORY_FILES;
+            return 0;
+        }
+      #endif  // def INCLUDE_PARAM_SNAPSHOT
+      #ifdef INCLUDE_PARAM_DB
+        if (fid == PARAM_DB_FILE_ID)
+        {
+            sFid_index = NUM_FILES + NUM_HISTORY_FILES + NUM_SNAPSHOT_FILES;
+            return 0;
+        }
+      #endif  // def INCLUDE_PARAM_DB
         i3_log(LOG_MASK_ERROR, "crcb_file_discover_reset(%d): invalid FID, using 0.", fid);
         sFid_index = 0;
         return 0;
@@ -133,12 +230,18 @@
 
     int crcb_file_discover_next(cr_FileInfo *file_desc)
     {
-        if (sFid_index >= NUM_FILES)
+        if (sFid_index >= (NUM_FILES + NUM_VIRTUAL_FILES))
         {
-            i3_log(LOG_MASK_WARN, "%s: sFid_index (%d) >= NUM_FILES (%d)",
-                   __FUNCTION__, sFid_index, NUM_FILES);
+            i3_log(LOG_MASK_WARN, "%s: sFid_index (%d) >= file count (%d)",
+                   __FUNCTION__, sFid_index, NUM_FILES + NUM_VIRTUAL_FILES);
             return cr_ErrorCodes_BAD_FILE;
         }
+        if (sFid_index >= NUM_FILES)
+        {
+            int rval = get_virtual_file_description(sFid_index - NUM_FILES, file_desc);
+            sFid_index++;
+            return rval;
+        }
         *file_desc = sFiles[sFid_index];
         sFid_index++;
         return 0;
@@ -154,6 +257,18 @@
                      uint8_t *pData,                // where the data goes
                      int *bytes_read)               // bytes actually read, negative for errors.
     {
+      #ifdef INCLUDE_PARAM_HISTORY
+        if (fid == PARAM_HISTORY_FILE_ID)
+            return param_history_read(offset, bytes_requested, pData, bytes_read);
+      #endif  // def INCLUDE_PARAM_HISTORY
+      #ifdef INCLUDE_PARAM_SNAPSHOT
+        if (fid == PARAM_SNAPSHOT_FILE_ID)
+            return param_snapshot_read(offset, bytes_requested, pData, bytes_read);
+      #endif  // def INCLUDE_PARAM_SNAPSHOT
+      #ifdef INCLUDE_PARAM_DB
+        if (fid == PARAM_DB_FILE_ID)
+            return param_db_read(offset, bytes_requested, pData, bytes_read);
+      #endif  // def INCLUDE_PARAM_DB
         if (fid > 1)
         {
             i3_log(LOG_MASK_ERROR, "%s: File ID %d does not exist.", __FUNCTION__, fid);
@@ -205,6 +320,21 @@
         return 0;
     }
 
+  #ifdef INCLUDE_FILE_MAPPED_READS
+    // ota.bin is read from code in flash, which is mapped in memory.
+    // The stack sends it from there without calling crcb_read_file().
+    int crcb_file_get_mapped_data(const uint32_t fid,
+                                  const uint32_t offset,
+                                  const size_t bytes,
+                                  const uint8_t **ppData)
+    {
+        if ((fid != 1) || (offset + bytes > (size_t)sFiles[1].current_size_bytes))
+            return cr_ErrorCodes_NOT_IMPLEMENTED;
+        *ppData = (const uint8_t *)(void*)&crcb_file_get_description + offset;
+        return 0;
+    }
+  #endif  // def INCLUDE_FILE_MAPPED_READS
+
     // returns zero or an error code
     // In this example the received data is not stored.
     // A real application can store the data as appropriate.
@@ -217,6 +347,10 @@
         (void)bytes;
         (void)pData;
 
+      #ifdef INCLUDE_PARAM_SNAPSHOT
+        if (fid == PARAM_SNAPSHOT_FILE_ID)
+            return param_snapshot_write(offset, bytes, pData);
+      #endif  // def INCLUDE_PARAM_SNAPSHOT
         if (fid > 1)
         {
             i3_log(LOG_MASK_ERROR, "%s: File ID %d does not exist.",
@@ -236,6 +370,13 @@
     // returns zero or an error code
     int crcb_erase_file(const uint32_t fid)
     {
+      #ifdef INCLUDE_PARAM_SNAPSHOT
+        if (fid == PARAM_SNAPSHOT_FILE_ID)
+        {
+            param_snapshot_select_all();
+            return 0;
+        }
+      #endif  // def INCLUDE_PARAM_SNAPSHOT
         if (fid > 1)
         {
             i3_log(LOG_MASK_ERROR, "%s: File ID %d does not exist.",
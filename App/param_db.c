@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2023-2024 i3 Product Development
+ * 
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/********************************************************************************************
+ *    _ ____  ___             _         _     ___              _                        _
+ *   (_)__ / | _ \_ _ ___  __| |_  _ __| |_  |   \ _____ _____| |___ _ __ _ __  ___ _ _| |_
+ *   | ||_ \ |  _/ '_/ _ \/ _` | || / _|  _| | |) / -_) V / -_) / _ \ '_ \ '  \/ -_) ' \  _|
+ *   |_|___/ |_| |_| \___/\__,_|\_,_\__|\__| |___/\___|\_/\___|_\___/ .__/_|_|_\___|_||_\__|
+ *                                                                  |_|
+ *                           -----------------------------------
+ *                          Copyright i3 Product Development 2023
+ * 
+ * \brief Serves the parameter description database as one file.
+ *
+ ********************************************************************************************/
+
+/**
+ * @file      param_db.c
+ * @brief     An example of a cacheable parameter description database.  
+ *            DISCOVER_PARAMETERS and DISCOVER_PARAM_EX return a few 
+ *            descriptions per message.  This file serves all of them as one
+ *            read-only file that a client pulls with a single file transfer
+ *            when its cache does not match the parameter metadata hash.  This
+ *            file is part of the application and NOT part of the core stack.
+ * @copyright (c) Copyright 2023 i3 Product Development. All Rights Reserved.
+ * The Cygngus Reach firmware stack is shared under an MIT license.
+ *
+ * The content is encoded on the fly from the description tables, so no RAM
+ * copy of the database is needed.  The tables are walked directly rather 
+ * than with the discovery callbacks, whose cursor belongs to the protocol.
+ * Reads are expected to be sequential.  A read before the current position
+ * restarts the encoding.  The descriptions are const, so the size is 
+ * computed once.
+ * 
+ * A client can read only the header to compare the hash with its cache.
+ * 
+ * File format, little endian:
+ *   File header (12 bytes):
+ *     "RPD", uint8 format version, uint32 parameter metadata hash as 
+ *     reported in the device info, uint16 number of parameter descriptions,
+ *     uint16 number of extended descriptions.
+ *   Each parameter description as a length delimited cr_ParameterInfo:  
+ *     varint length followed by the protobuf encoding, in discovery order.
+ *   Each extended description as a length delimited cr_ParamExInfoResponse.
+ */
+
+#include "reach-server.h"  // configures Reach
+
+#ifdef INCLUDE_PARAM_DB
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "cr_stack.h"
+#include "i3_log.h"
+#include "pb_encode.h"
+#include "param_db.h"
+#include "param_store.h"
+
+#ifndef INCLUDE_FILE_SERVICE
+    #error "INCLUDE_PARAM_DB requires INCLUDE_FILE_SERVICE."
+#endif
+#ifndef INCLUDE_PARAMETER_SERVICE
+    #error "INCLUDE_PARAM_DB requires INCLUDE_PARAMETER_SERVICE."
+#endif
+
+#define PD_FORMAT_VERSION           1
+#define PD_FILE_HEADER_SIZE         12
+// The largest entry with its varint length.
+#define PD_MAX_ENTRY_SIZE           (cr_ParamExInfoResponse_size + 2)
+
+typedef enum {
+    PD_SECTION_HEADER,
+    PD_SECTION_PARAMS,
+    PD_SECTION_EX,
+    PD_SECTION_END
+} pd_section_t;
+
+// The encoding position.  One entry at a time is held in sPd_entry.
+typedef struct {
+    pd_section_t section;
+    int          index;         // within the section
+    uint32_t     entry_start;   // file offset of the entry
+    size_t       entry_len;
+} pd_cursor_t;
+
+static pd_cursor_t sPd_cursor;
+static uint8_t     sPd_entry[PD_MAX_ENTRY_SIZE];
+static uint32_t    sPd_size = 0;       // zero until computed
+static int         sPd_num_params = 0;
+static int         sPd_num_ex = 0;
+
+static const cr_ParamExInfoResponse *sPd_ex_desc = NULL;
+static int         sPd_ex_count = 0;
+
+static void pd_put(uint8_t *pDst, uint32_t val, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        pDst[i] = val & 0xFF;
+        val >>= 8;
+    }
+}
+
+static void pd_restart(void)
+{
+    sPd_num_params = param_store_count();
+    sPd_num_ex = sPd_ex_count;
+
+    memcpy(sPd_entry, "RPD", 3);
+    sPd_entry[3] = PD_FORMAT_VERSION;
+    pd_put(&sPd_entry[4], crcb_compute_parameter_hash(), 4);
+    pd_put(&sPd_entry[8], sPd_num_params, 2);
+    pd_put(&sPd_entry[10], sPd_num_ex, 2);
+
+    sPd_cursor.section = PD_SECTION_HEADER;
+    sPd_cursor.index = 0;
+    sPd_cursor.entry_start = 0;
+    sPd_cursor.entry_len = PD_FILE_HEADER_SIZE;
+}
+
+// Encodes the entry at the cursor into sPd_entry.  
+// Moves on to the end if there is none.
+static void pd_encode_entry(void)
+{
+    pb_ostream_t os = pb_ostream_from_buffer(sPd_entry, sizeof(sPd_entry));
+    bool ok = false;
+
+    if (sPd_cursor.section == PD_SECTION_PARAMS)
+    {
+        const cr_ParameterInfo *desc = param_store_description(sPd_cursor.index);
+        if (desc != NULL)
+            ok = pb_encode_delimited(&os, cr_ParameterInfo_fields, desc);
+    }
+    else if ((sPd_cursor.section == PD_SECTION_EX) && (sPd_cursor.index < sPd_ex_count))
+    {
+        ok = pb_encode_delimited(&os, cr_ParamExInfoResponse_fields, 
+                                 &sPd_ex_desc[sPd_cursor.index]);
+    }
+    if (!ok)
+    {
+        if (sPd_cursor.section != PD_SECTION_END)
+        {
+            LOG_ERROR("Param DB: entry %d of section %d failed.", 
+                      sPd_cursor.index, sPd_cursor.section);
+        }
+        sPd_cursor.section = PD_SECTION_END;
+        sPd_cursor.entry_len = 0;
+        return;
+    }
+    sPd_cursor.entry_len = os.bytes_written;
+}
+
+// Advances the cursor to the following entry.
+static void pd_next(void)
+{
+    sPd_cursor.entry_start += sPd_cursor.entry_len;
+    sPd_cursor.index++;
+
+    if (sPd_cursor.section == PD_SECTION_HEADER)
+    {
+        sPd_cursor.section = PD_SECTION_PARAMS;
+        sPd_cursor.index = 0;
+    }
+    if ((sPd_cursor.section == PD_SECTION_PARAMS) && (sPd_cursor.index >= sPd_num_params))
+    {
+        sPd_cursor.section = PD_SECTION_EX;
+        sPd_cursor.index = 0;
+    }
+    if ((sPd_cursor.section == PD_SECTION_EX) && (sPd_cursor.index >= sPd_num_ex))
+        sPd_cursor.section = PD_SECTION_END;
+
+    pd_encode_entry();
+}
+
+void param_db_init(const cr_ParamExInfoResponse *ex_desc, int ex_count)
+{
+    sPd_ex_desc = ex_desc;
+    sPd_ex_count = (ex_desc != NULL) ? ex_count : 0;
+    sPd_size = 0;
+}
+
+void param_db_get_description(cr_FileInfo *file_desc)
+{
+    if (sPd_size == 0)
+    {
+        // Walk the whole database once to find its size.
+        pd_restart();
+        while (sPd_cursor.section != PD_SECTION_END)
+            pd_next();
+        sPd_size = sPd_cursor.entry_start;
+        pd_restart();
+        I3_LOG(LOG_MASK_FILES, "Param DB of %d + %d descriptions, %d bytes.", 
+               sPd_num_params, sPd_num_ex, sPd_size);
+    }
+
+    memset(file_desc, 0, sizeof(cr_FileInfo));
+    file_desc->file_id = PARAM_DB_FILE_ID;
+    strncpy(file_desc->file_name, "param_db.bin", sizeof(file_desc->file_name));
+    file_desc->access = cr_AccessLevel_READ;
+    file_desc->current_size_bytes = sPd_size;
+    file_desc->storage_location = cr_StorageLocation_RAM;
+}
+
+int param_db_read(const int offset, const size_t bytes_requested,
+                  uint8_t *pData, int *bytes_read)
+{
+    if (sPd_size == 0)
+    {   // a read without a preceding description.
+        cr_FileInfo file_desc;
+        param_db_get_description(&file_desc);
+    }
+    if ((offset < 0) || ((uint32_t)offset >= sPd_size))
+    {
+        i3_log(LOG_MASK_ERROR, "%s: offset %d is beyond the database size %d.",
+               __FUNCTION__, offset, sPd_size);
+        *bytes_read = 0;
+        return cr_ErrorCodes_INVALID_PARAMETER;
+    }
+
+    uint32_t pos = offset;
+    uint32_t end = offset + bytes_requested;
+    if (end > sPd_size)
+        end = sPd_size;
+
+    if (pos < sPd_cursor.entry_start)
+        pd_restart();
+
+    while (pos < end)
+    {
+        uint32_t entry_end = sPd_cursor.entry_start + sPd_cursor.entry_len;
+        if (pos >= entry_end)
+        {
+            pd_next();
+            if (sPd_cursor.section == PD_SECTION_END)
+            {
+                LOG_ERROR("Param DB changed while being read.");
+                *bytes_read = 0;
+                return cr_ErrorCodes_READ_FAILED;
+            }
+            continue;
+        }
+        uint32_t len = (end < entry_end ? end : entry_end) - pos;
+        memcpy(pData, &sPd_entry[pos - sPd_cursor.entry_start], len);
+        pData += len;
+        pos += len;
+    }
+    *bytes_read = end - offset;
+    return 0;
+}
+
+#endif  // def INCLUDE_PARAM_DB
@@ -0,0 +1,441 @@
+/*
+ * Copyright (c) 2023-2024 i3 Product Development
+ * 
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/********************************************************************************************
+ *    _ ____  ___             _         _     ___              _                        _
+ *   (_)__ / | _ \_ _ ___  __| |_  _ __| |_  |   \ _____ _____| |___ _ __ _ __  ___ _ _| |_
+ *   | ||_ \ |  _/ '_/ _ \/ _` | || / _|  _| | |) / -_) V / -_) / _ \ '_ \ '  \/ -_) ' \  _|
+ *   |_|___/ |_| |_| \___/\__,_|\_,_\__|\__| |___/\___|\_/\___|_\___/ .__/_|_|_\___|_||_\__|
+ *                                                                  |_|
+ *                           -----------------------------------
+ *                          Copyright i3 Product Development 2023
+ * 
+ * \brief Records a compressed history of selected parameters.
+ *
+ ********************************************************************************************/
+
+/**
+ * @file      param_history.c
+ * @brief     An example of an on-device parameter history.  Selected 
+ *            parameters are sampled periodically into a RAM ring and the ring
+ *            is exposed as a read-only file, so a client can pull a long trend
+ *            with one file transfer instead of polling each sample.  This file
+ *            is part of the application and NOT part of the core stack.
+ * @copyright (c) Copyright 2023 i3 Product Development. All Rights Reserved.
+ * The Cygngus Reach firmware stack is shared under an MIT license.
+ *
+ * Each recorded parameter owns a ring of fixed size blocks.  Samples are 
+ * compressed into the newest block.  When the ring is full the oldest block
+ * is discarded.  Every block can be decoded on its own.
+ *
+ * Sample encoding, relative to the previous sample in the same block:
+ *   - timestamp:  The first sample in a block holds the absolute timestamp.
+ *                 Later samples hold the change in the sampling interval 
+ *                 (delta of delta), zigzag varint.  Steady sampling costs 
+ *                 one byte.
+ *   - float:      The IEEE bit pattern XOR'ed with the previous pattern, 
+ *                 varint.  Unchanged values cost one byte, small changes 
+ *                 leave the high bits zero.
+ *   - others:     The difference from the previous value, zigzag varint.
+ *                 Strings and byte arrays are not recorded.
+ * 
+ * File format, all little endian:
+ *   File header (12 bytes):
+ *     "RPH", uint8 format version, uint32 timestamp of the snapshot, 
+ *     uint16 ticks per second, uint8 number of series, uint8 reserved.
+ *   For each series, a series header (8 bytes):
+ *     uint32 parameter ID, uint8 cr_ParameterValue value tag, 
+ *     uint8 number of blocks, uint16 number of samples.
+ *   For each block of the series, oldest first, a block header (4 bytes):
+ *     uint16 bytes of samples, uint16 number of samples, followed by the 
+ *     encoded samples.
+ */
+
+#include "reach-server.h"  // configures Reach
+
+#ifdef INCLUDE_PARAM_HISTORY
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "cr_stack.h"
+#include "i3_log.h"
+#include "param_history.h"
+
+#ifndef INCLUDE_FILE_SERVICE
+    #error "INCLUDE_PARAM_HISTORY requires INCLUDE_FILE_SERVICE."
+#endif
+
+#define PH_FORMAT_VERSION           1
+#define PH_FILE_HEADER_SIZE         12
+#define PH_SERIES_HEADER_SIZE       8
+#define PH_BLOCK_HEADER_SIZE        4
+// A timestamp and a 64 bit value, each a worst case varint.
+#define PH_MAX_SAMPLE_SIZE          (5 + 10)
+// Sampling resumes if a frozen history is not read for this long.  The 
+// reader may ask for the last window again, so reaching the end does not 
+// end the freeze.
+#define PH_FREEZE_TIMEOUT_MS        10000
+
+typedef struct {
+    uint32_t pid;
+    uint32_t period_ms;
+} ph_config_t;
+
+// The parameters to be recorded and how often.
+// In this demo, pid 5 is a float and pid 69 counts up once per second.
+static const ph_config_t sPh_config[] =
+{
+    { 5,    PARAM_HISTORY_DEFAULT_PERIOD_MS },
+    { 69,   PARAM_HISTORY_DEFAULT_PERIOD_MS },
+};
+#define PH_NUM_SERIES   (sizeof(sPh_config)/sizeof(sPh_config[0]))
+
+typedef struct {
+    uint16_t bytes_used;
+    uint16_t num_samples;
+    uint8_t  data[PARAM_HISTORY_BLOCK_SIZE];
+} ph_block_t;
+
+typedef struct {
+    pb_size_t   which_value;    // zero until the first sample
+    bool        has_sampled;
+    uint32_t    last_sample;    // ticks
+    uint8_t     oldest;         // index of the oldest block in the ring
+    uint8_t     num_blocks;     // blocks in use, the newest is being filled
+    // encoder state for the newest block
+    uint32_t    prev_timestamp;
+    int64_t     prev_interval;
+    uint64_t    prev_bits;
+    ph_block_t  blocks[PARAM_HISTORY_BLOCKS_PER_PID];
+} ph_series_t;
+
+static ph_series_t sPh_series[PH_NUM_SERIES];
+
+static bool     sPh_frozen = false;
+static uint32_t sPh_frozen_at = 0;      // snapshot time, reported in the header
+static uint32_t sPh_last_read = 0;      // for the freeze timeout
+static uint32_t sPh_frozen_size = 0;
+
+static int ph_put_varint(uint8_t *pDst, uint64_t val)
+{
+    int len = 0;
+    do {
+        uint8_t byte = val & 0x7F;
+        val >>= 7;
+        if (val)
+            byte |= 0x80;
+        pDst[len++] = byte;
+    } while (val);
+    return len;
+}
+
+static uint64_t ph_zigzag(int64_t val)
+{
+    return ((uint64_t)val << 1) ^ (uint64_t)(val >> 63);
+}
+
+// Returns false for types that are not recorded.
+static bool ph_value_bits(const cr_ParameterValue *param, uint64_t *bits)
+{
+    switch (param->which_value)
+    {
+    case cr_ParameterValue_uint32_value_tag:
+        *bits = param->value.uint32_value;
+        return true;
+    case cr_ParameterValue_sint32_value_tag:
+        *bits = (uint64_t)(int64_t)param->value.sint32_value;
+        return true;
+    case cr_ParameterValue_float32_value_tag:
+    {
+        uint32_t raw;
+        memcpy(&raw, &param->value.float32_value, sizeof(raw));
+        *bits = raw;
+        return true;
+    }
+    case cr_ParameterValue_uint64_value_tag:
+        *bits = param->value.uint64_value;
+        return true;
+    case cr_ParameterValue_sint64_value_tag:
+        *bits = (uint64_t)param->value.sint64_value;
+        return true;
+    case cr_ParameterValue_float64_value_tag:
+        memcpy(bits, &param->value.float64_value, sizeof(*bits));
+        return true;
+    case cr_ParameterValue_bool_value_tag:
+        *bits = param->value.bool_value ? 1 : 0;
+        return true;
+    case cr_ParameterValue_enum_value_tag:
+        *bits = param->value.enum_value;
+        return true;
+    case cr_ParameterValue_bitfield_value_tag:
+        *bits = param->value.bitfield_value;
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+static ph_block_t *ph_start_block(ph_series_t *series)
+{
+    if (series->num_blocks < PARAM_HISTORY_BLOCKS_PER_PID)
+    {
+        series->num_blocks++;
+    }
+    else
+    {   // full, discard the oldest
+        series->oldest = (series->oldest + 1) % PARAM_HISTORY_BLOCKS_PER_PID;
+    }
+    int newest = (series->oldest + series->num_blocks - 1) % PARAM_HISTORY_BLOCKS_PER_PID;
+    ph_block_t *block = &series->blocks[newest];
+    block->bytes_used = 0;
+    block->num_samples = 0;
+    series->prev_timestamp = 0;
+    series->prev_interval = 0;
+    series->prev_bits = 0;
+    return block;
+}
+
+static void ph_record(ph_series_t *series, uint32_t timestamp, uint64_t bits)
+{
+    ph_block_t *block = NULL;
+    if (series->num_blocks > 0)
+    {
+        int newest = (series->oldest + series->num_blocks - 1) % PARAM_HISTORY_BLOCKS_PER_PID;
+        block = &series->blocks[newest];
+        if ((block->bytes_used + PH_MAX_SAMPLE_SIZE) > PARAM_HISTORY_BLOCK_SIZE)
+            block = NULL;
+    }
+    if (block == NULL)
+        block = ph_start_block(series);
+
+    uint8_t *pDst = &block->data[block->bytes_used];
+    int len;
+    if (block->num_samples == 0)
+    {
+        len = ph_put_varint(pDst, timestamp);
+    }
+    else
+    {
+        int64_t interval = (int64_t)timestamp - (int64_t)series->prev_timestamp;
+        len = ph_put_varint(pDst, ph_zigzag(interval - series->prev_interval));
+        series->prev_interval = interval;
+    }
+
+    if ((series->which_value == cr_ParameterValue_float32_value_tag) ||
+        (series->which_value == cr_ParameterValue_float64_value_tag))
+        len += ph_put_varint(pDst + len, bits ^ series->prev_bits);
+    else
+        len += ph_put_varint(pDst + len, ph_zigzag((int64_t)(bits - series->prev_bits)));
+
+    series->prev_timestamp = timestamp;
+    series->prev_bits = bits;
+    block->bytes_used += len;
+    block->num_samples++;
+}
+
+void param_history_init(void)
+{
+    memset(sPh_series, 0, sizeof(sPh_series));
+    sPh_frozen = false;
+    I3_LOG(LOG_MASK_PARAMS, "Param history: %d series of %d blocks of %d bytes.",
+           (int)PH_NUM_SERIES, PARAM_HISTORY_BLOCKS_PER_PID, PARAM_HISTORY_BLOCK_SIZE);
+}
+
+void param_history_sample(uint32_t timestamp)
+{
+    if (sPh_frozen)
+    {
+        if ((timestamp - sPh_last_read) < PH_FREEZE_TIMEOUT_MS)
+            return;
+        I3_LOG(LOG_MASK_FILES, "Param history reader is quiet, resume sampling.");
+        sPh_frozen = false;
+    }
+
+    for (size_t i=0; i<PH_NUM_SERIES; i++)
+    {
+        ph_series_t *series = &sPh_series[i];
+        if (series->has_sampled && 
+            ((timestamp - series->last_sample) < sPh_config[i].period_ms))
+            continue;
+
+        cr_ParameterValue param;
+        int rval = cr_parameter_read(sPh_config[i].pid, &param);
+        if (rval == cr_ErrorCodes_PENDING)
+            continue;   // sampled on a later call, once the value is ready.
+        series->has_sampled = true;
+        series->last_sample = timestamp;
+        if (rval != 0)
+            continue;
+
+        uint64_t bits;
+        if (!ph_value_bits(&param, &bits))
+        {
+            I3_LOG(LOG_MASK_WARN, "Param history: pid %d type %d is not recorded.",
+                   sPh_config[i].pid, param.which_value);
+            continue;
+        }
+        if (series->which_value != param.which_value)
+        {   // first sample, or the type changed.  Start over.
+            memset(series, 0, sizeof(ph_series_t));
+            series->has_sampled = true;
+            series->last_sample = timestamp;
+            series->which_value = param.which_value;
+        }
+        ph_record(series, timestamp, bits);
+    }
+}
+
+// Walks the virtual file, copying the bytes that fall in [offset, end).
+// With end at zero nothing is copied and pos ends at the file size.
+typedef struct {
+    uint32_t pos;
+    uint32_t offset;
+    uint32_t end;
+    uint8_t  *pData;
+} ph_cursor_t;
+
+static void ph_emit(ph_cursor_t *cursor, const uint8_t *pSrc, uint32_t len)
+{
+    uint32_t start = cursor->pos;
+    cursor->pos += len;
+    if ((cursor->pos <= cursor->offset) || (start >= cursor->end))
+        return;
+
+    uint32_t from = (start < cursor->offset) ? (cursor->offset - start) : 0;
+    uint32_t to = (cursor->pos > cursor->end) ? (cursor->end - start) : len;
+    memcpy(cursor->pData + (start + from - cursor->offset), pSrc + from, to - from);
+}
+
+static void ph_put_u16(uint8_t *pDst, uint16_t val)
+{
+    pDst[0] = val & 0xFF;
+    pDst[1] = val >> 8;
+}
+
+static void ph_put_u32(uint8_t *pDst, uint32_t val)
+{
+    ph_put_u16(pDst, val & 0xFFFF);
+    ph_put_u16(pDst + 2, val >> 16);
+}
+
+static void ph_walk(ph_cursor_t *cursor)
+{
+    uint8_t hdr[PH_FILE_HEADER_SIZE];
+
+    memcpy(hdr, "RPH", 3);
+    hdr[3] = PH_FORMAT_VERSION;
+    ph_put_u32(&hdr[4], sPh_frozen ? sPh_frozen_at : cr_get_current_ticks());
+    ph_put_u16(&hdr[8], SYS_TICK_RATE);
+    hdr[10] = PH_NUM_SERIES;
+    hdr[11] = 0;
+    ph_emit(cursor, hdr, PH_FILE_HEADER_SIZE);
+
+    for (size_t i=0; i<PH_NUM_SERIES; i++)
+    {
+        const ph_series_t *series = &sPh_series[i];
+        uint16_t num_samples = 0;
+        for (int b=0; b<series->num_blocks; b++)
+            num_samples += series->blocks[(series->oldest + b) % PARAM_HISTORY_BLOCKS_PER_PID].num_samples;
+
+        ph_put_u32(&hdr[0], sPh_config[i].pid);
+        hdr[4] = (uint8_t)series->which_value;
+        hdr[5] = series->num_blocks;
+        ph_put_u16(&hdr[6], num_samples);
+        ph_emit(cursor, hdr, PH_SERIES_HEADER_SIZE);
+
+        for (int b=0; b<series->num_blocks; b++)
+        {
+            const ph_block_t *block = 
+                &series->blocks[(series->oldest + b) % PARAM_HISTORY_BLOCKS_PER_PID];
+            ph_put_u16(&hdr[0], block->bytes_used);
+            ph_put_u16(&hdr[2], block->num_samples);
+            ph_emit(cursor, hdr, PH_BLOCK_HEADER_SIZE);
+            ph_emit(cursor, block->data, block->bytes_used);
+        }
+    }
+}
+
+static uint32_t ph_get_size(void)
+{
+    ph_cursor_t cursor = {0, 0, 0, NULL};
+    ph_walk(&cursor);
+    return cursor.pos;
+}
+
+void param_history_get_description(cr_FileInfo *file_desc)
+{
+    memset(file_desc, 0, sizeof(cr_FileInfo));
+    file_desc->file_id = PARAM_HISTORY_FILE_ID;
+    strncpy(file_desc->file_name, "param_history.bin", sizeof(file_desc->file_name));
+    file_desc->access = cr_AccessLevel_READ;
+    file_desc->current_size_bytes = sPh_frozen ? sPh_frozen_size : ph_get_size();
+    file_desc->storage_location = cr_StorageLocation_RAM;
+}
+
+void param_history_freeze(uint32_t timestamp)
+{
+    if (sPh_frozen && ((timestamp - sPh_last_read) < PH_FREEZE_TIMEOUT_MS))
+    {
+        // Another transfer is reading.  Its content must not change.
+        I3_LOG(LOG_MASK_FILES, "Param history stays frozen at %d bytes.", sPh_frozen_size);
+        return;
+    }
+    sPh_frozen = false;
+    sPh_frozen_size = ph_get_size();
+    sPh_frozen_at = timestamp;
+    sPh_last_read = timestamp;
+    sPh_frozen = true;
+    I3_LOG(LOG_MASK_FILES, "Param history frozen at %d bytes.", sPh_frozen_size);
+}
+
+int param_history_read(const int offset, const size_t bytes_requested,
+                       uint8_t *pData, int *bytes_read)
+{
+    if (!sPh_frozen)
+    {   // a read without a preceding description.
+        param_history_freeze(cr_get_current_ticks());
+    }
+    if ((offset < 0) || ((uint32_t)offset >= sPh_frozen_size))
+    {
+        i3_log(LOG_MASK_ERROR, "%s: offset %d is beyond the history size %d.",
+               __FUNCTION__, offset, sPh_frozen_size);
+        *bytes_read = 0;
+        return cr_ErrorCodes_INVALID_PARAMETER;
+    }
+
+    uint32_t end = offset + bytes_requested;
+    if (end > sPh_frozen_size)
+        end = sPh_frozen_size;
+
+    ph_cursor_t cursor = {0, (uint32_t)offset, end, pData};
+    ph_walk(&cursor);
+    *bytes_read = end - offset;
+    sPh_last_read = cr_get_current_ticks();
+    return 0;
+}
+
+#endif  // def INCLUDE_PARAM_HISTORY
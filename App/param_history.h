@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2023-2024 i3 Product Development
+ * 
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/********************************************************************************************
+ *    _ ____  ___             _         _     ___              _                        _
+ *   (_)__ / | _ \_ _ ___  __| |_  _ __| |_  |   \ _____ _____| |___ _ __ _ __  ___ _ _| |_
+ *   | ||_ \ |  _/ '_/ _ \/ _` | || / _|  _| | |) / -_) V / -_) / _ \ '_ \ '  \/ -_) ' \  _|
+ *   |_|___/ |_| |_| \___/\__,_|\_,_\__|\__| |___/\___|\_/\___|_\___/ .__/_|_|_\___|_||_\__|
+ *                                                                  |_|
+ *                           -----------------------------------
+ *                          Copyright i3 Product Development 2023
+ * 
+ * \brief Records a compressed history of selected parameters.
+ *
+ ********************************************************************************************/
+
+/**
+ * @file      param_history.h
+ * @brief     Interface to the parameter history recorder.  The history is 
+ *            exposed through the file service as a read-only file.  The file
+ *            format is described in param_history.c.
+ * @copyright (c) Copyright 2023 i3 Product Development. All Rights Reserved.
+ * The Cygngus Reach firmware stack is shared under an MIT license.
+ */
+
+#ifndef _PARAM_HISTORY_H_
+#define _PARAM_HISTORY_H_
+
+#include "reach-server.h"
+
+#ifdef INCLUDE_PARAM_HISTORY
+
+#include <stdint.h>
+#include <stddef.h>
+#include "reach.pb.h"
+
+/// Clears all recorded history.  Call after the parameter repository is 
+/// initialized.
+void param_history_init(void);
+
+/// Call periodically.  Samples each recorded parameter whose period has elapsed.
+void param_history_sample(uint32_t timestamp);
+
+/// Describes the history file.  The size reflects the current content.
+void param_history_get_description(cr_FileInfo *file_desc);
+
+/// Freezes the recorder so that the size reported by the following 
+/// description remains valid while the file is read.  A retried read gets 
+/// the same content.  Sampling resumes when the reader goes quiet.  The 
+/// next transfer init freezes it again at the current content, unless a 
+/// reader is still active.  That transfer then reads the same content.
+void param_history_freeze(uint32_t timestamp);
+
+/// Copies part of the history file.  Returns zero or an error code.
+int param_history_read(const int offset, const size_t bytes_requested,
+                       uint8_t *pData, int *bytes_read);
+
+#endif  // def INCLUDE_PARAM_HISTORY
+
+#endif  // ndef _PARAM_HISTORY_H_
@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2023-2024 i3 Product Development
+ * 
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/********************************************************************************************
+ *    _ ____  ___             _         _     ___              _                        _
+ *   (_)__ / | _ \_ _ ___  __| |_  _ __| |_  |   \ _____ _____| |___ _ __ _ __  ___ _ _| |_
+ *   | ||_ \ |  _/ '_/ _ \/ _` | || / _|  _| | |) / -_) V / -_) / _ \ '_ \ '  \/ -_) ' \  _|
+ *   |_|___/ |_| |_| \___/\__,_|\_,_\__|\__| |___/\___|\_/\___|_\___/ .__/_|_|_\___|_||_\__|
+ *                                                                  |_|
+ *                           -----------------------------------
+ *                          Copyright i3 Product Development 2023
+ * 
+ * \brief Stores parameter values in NVM as packed records.
+ *
+ ********************************************************************************************/
+
+/**
+ * @file      param_nvm.c
+ * @brief     Stores the NONVOLATILE parameters in a few NVM3 objects rather 
+ *            than one object per parameter.  Each record holds a version 
+ *            followed by the packed values of consecutive parameters, so 
+ *            the whole repository is restored at boot in a few reads.  This 
+ *            file is part of the application and NOT part of the core stack.
+ * @copyright (c) Copyright 2023 i3 Product Development. All Rights Reserved.
+ * The Cygngus Reach firmware stack is shared under an MIT license.
+ *
+ * Record layout:
+ *   uint32 layout version, then the packed value of each parameter in the
+ *   record, in description order.  See param_store_pack().
+ * The layout version is a hash of the ID, type and packed size of every 
+ * NONVOLATILE parameter.  A record written by firmware with a different 
+ * parameter set is discarded and rebuilt from the defaults.
+ *
+ * After a factory reset the generation counter, a separate object, is mixed 
+ * into the version.  That invalidates every record at the cost of one small 
+ * write instead of erasing NVM.  Records that do not match are rebuilt later,
+ * one per call of param_nvm_idle().
+ *
+ * Earlier firmware stored each parameter as a cr_ParameterValue under its 
+ * parameter ID.  Those objects are migrated into records and deleted.  They
+ * predate the generation counter, so are only migrated in generation zero.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "reach-server.h"  // configures Reach
+#include "nvm3_default.h"
+
+#include "cr_stack.h"
+#include "i3_log.h"
+#include "param_store.h"
+#include "param_nvm.h"
+
+#define PN_HEADER_SIZE      4
+#define PN_NOT_NVM          0xFF
+
+static const cr_ParameterInfo *sPn_desc = NULL;
+static int      sPn_count = 0;
+static int      sPn_num_records = 0;
+static uint32_t sPn_version = 0;
+static uint32_t sPn_layout = 0;
+static uint32_t sPn_generation = 0;
+// Records to be rewritten by param_nvm_idle().
+static bool     sPn_stale[PARAM_NVM_MAX_RECORDS];
+// The record holding each parameter, or PN_NOT_NVM.
+static uint8_t  sPn_record_of[PARAM_STORE_MAX_PARAMS];
+// The total size of each record.
+static uint16_t sPn_record_size[PARAM_NVM_MAX_RECORDS];
+static uint8_t  sPn_buffer[PARAM_NVM_RECORD_SIZE];
+
+static void pn_hash(uint32_t *hash, uint32_t val)
+{
+    // FNV-1a, one byte at a time.
+    for (int i=0; i<4; i++) {
+        *hash ^= (val >> (8*i)) & 0xFF;
+        *hash *= 16777619;
+    }
+}
+
+// Generation zero is not mixed in, so records written before there was a 
+// generation counter remain valid.
+static void pn_set_version(void)
+{
+    sPn_version = sPn_layout;
+    if (sPn_generation != 0)
+        pn_hash(&sPn_version, sPn_generation);
+}
+
+// Reads a counter kept as a separate object.  Missing counters read zero.
+static uint32_t pn_read_counter(nvm3_ObjectKey_t key)
+{
+    uint32_t objectType;
+    size_t dataLen;
+    uint32_t counter = 0;
+    Ecode_t eCode = nvm3_getObjectInfo(nvm3_defaultHandle, key, &objectType, &dataLen);
+    if ((eCode != ECODE_NVM3_OK) || (objectType != NVM3_OBJECTTYPE_DATA) ||
+        (dataLen != sizeof(counter)))
+        return 0;
+    eCode = nvm3_readData(nvm3_defaultHandle, key, &counter, sizeof(counter));
+    if (eCode != ECODE_NVM3_OK)
+        return 0;
+    return counter;
+}
+
+static void pn_read_generation(void)
+{
+    sPn_generation = pn_read_counter(PARAM_NVM_GENERATION_KEY);
+}
+
+int param_nvm_init(const cr_ParameterInfo *desc, int count)
+{
+    int record = 0;
+    size_t used = PN_HEADER_SIZE;
+
+    sPn_layout = 2166136261;
+    pn_hash(&sPn_layout, PARAM_NVM_RECORD_SIZE);
+    memset(sPn_record_size, 0, sizeof(sPn_record_size));
+    memset(sPn_stale, 0, sizeof(sPn_stale));
+
+    for (int i=0; i<count; i++)
+    {
+        sPn_record_of[i] = PN_NOT_NVM;
+        if (desc[i].storage_location != cr_StorageLocation_NONVOLATILE)
+            continue;
+
+        size_t len = param_store_packed_size(i);
+        if ((len + PN_HEADER_SIZE) > PARAM_NVM_RECORD_SIZE)
+        {
+            LOG_ERROR("pid %d does not fit in an NVM record.", desc[i].id);
+            return cr_ErrorCodes_NO_RESOURCE;
+        }
+        if ((used + len) > PARAM_NVM_RECORD_SIZE)
+        {
+            sPn_record_size[record] = used;
+            record++;
+            used = PN_HEADER_SIZE;
+        }
+        if (record >= PARAM_NVM_MAX_RECORDS)
+        {
+            LOG_ERROR("NVM parameters need more than %d records.", PARAM_NVM_MAX_RECORDS);
+            return cr_ErrorCodes_NO_RESOURCE;
+        }
+        sPn_record_of[i] = record;
+        used += len;
+        pn_hash(&sPn_layout, desc[i].id);
+        pn_hash(&sPn_layout, desc[i].data_type);
+        pn_hash(&sPn_layout, len);
+    }
+    sPn_num_records = 0;
+    if (used > PN_HEADER_SIZE)
+    {
+        sPn_record_size[record] = used;
+        sPn_num_records = record + 1;
+    }
+    sPn_desc = desc;
+    sPn_count = count;
+    pn_read_generation();
+    pn_set_version();
+    I3_LOG(LOG_MASK_PARAMS, "NVM parameters use %d records, version 0x%x, generation %d.", 
+           sPn_num_records, sPn_version, sPn_generation);
+    return 0;
+}
+
+static int pn_write_record(int record)
+{
+    size_t len = 0;
+
+    sPn_buffer[len++] = sPn_version & 0xFF;
+    sPn_buffer[len++] = (sPn_version >> 8) & 0xFF;
+    sPn_buffer[len++] = (sPn_version >> 16) & 0xFF;
+    sPn_buffer[len++] = (sPn_version >> 24) & 0xFF;
+    for (int i=0; i<sPn_count; i++)
+    {
+        if (sPn_record_of[i] == record)
+            len += param_store_pack(i, &sPn_buffer[len]);
+    }
+    affirm(len == sPn_record_size[record]);
+
+    Ecode_t eCode = nvm3_writeData(nvm3_defaultHandle, 
+                                   PARAM_NVM_RECORD_KEY_BASE + record,
+                                   sPn_buffer, len);
+    if (ECODE_NVM3_OK != eCode) {
+        i3_log(LOG_MASK_ERROR, "%s: NVM Write of record %d failed with 0x%x.", 
+               __FUNCTION__, record, eCode);
+        return cr_ErrorCodes_WRITE_FAILED;
+    }
+
+    // Do repacking if needed
+    if (nvm3_repackNeeded(nvm3_defaultHandle)) {
+        i3_log(LOG_MASK_ALWAYS, "Repacking NVM");
+        eCode = nvm3_repack(nvm3_defaultHandle);
+        if (eCode != ECODE_NVM3_OK) {
+            i3_log(LOG_MASK_ERROR, "%s: Error 0x%x repacking", __FUNCTION__, eCode);
+        }
+    }
+    sPn_stale[record] = false;
+    I3_LOG(LOG_MASK_REACH, "Wrote NVM record %d, %d bytes", record, len);
+    return cr_ErrorCodes_NO_ERROR;
+}
+
+static int pn_read_record(int record)
+{
+    uint32_t objectType;
+    size_t dataLen;
+    Ecode_t eCode = nvm3_getObjectInfo(nvm3_defaultHandle, 
+                                       PARAM_NVM_RECORD_KEY_BASE + record,
+                                       &objectType, &dataLen);
+    if ((eCode != ECODE_NVM3_OK) || (objectType != NVM3_OBJECTTYPE_DATA))
+        return cr_ErrorCodes_NO_DATA;
+    if (dataLen != sPn_record_size[record])
+        return cr_ErrorCodes_INVALID_STATE;
+
+    eCode = nvm3_readData(nvm3_defaultHandle, PARAM_NVM_RECORD_KEY_BASE + record,
+                          sPn_buffer, dataLen);
+    if (ECODE_NVM3_OK != eCode) {
+        i3_log(LOG_MASK_ERROR, "%s: NVM Read of record %d failed with 0x%x.", 
+               __FUNCTION__, record, eCode);
+        return cr_ErrorCodes_READ_FAILED;
+    }
+    uint32_t version = sPn_buffer[0] | (sPn_buffer[1] << 8) |
+                       (sPn_buffer[2] << 16) | ((uint32_t)sPn_buffer[3] << 24);
+    if (version != sPn_version)
+        return cr_ErrorCodes_INVALID_STATE;
+
+    size_t offset = PN_HEADER_SIZE;
+    for (int i=0; i<sPn_count; i++)
+    {
+        if (sPn_record_of[i] != record)
+            continue;
+        if (param_store_unpack(i, &sPn_buffer[offset]) != 0)
+            i3_log(LOG_MASK_WARN, "NVM record %d has a bad value for pid %d.", 
+                   record, sPn_desc[i].id);
+        offset += param_store_packed_size(i);
+    }
+    return cr_ErrorCodes_NO_ERROR;
+}
+
+// Moves values stored by earlier firmware, one object per parameter ID, 
+// into the store.  Returns the number found.
+static int pn_migrate_legacy(int record)
+{
+    int found = 0;
+    for (int i=0; i<sPn_count; i++)
+    {
+        if (sPn_record_of[i] != record)
+            continue;
+
+        uint32_t objectType;
+        size_t dataLen;
+        cr_ParameterValue param;
+        Ecode_t eCode = nvm3_getObjectInfo(nvm3_defaultHandle, sPn_desc[i].id,
+                                           &objectType, &dataLen);
+        if ((eCode != ECODE_NVM3_OK) || (objectType != NVM3_OBJECTTYPE_DATA) ||
+            (dataLen != sizeof(cr_ParameterValue)))
+            continue;
+        eCode = nvm3_readData(nvm3_defaultHandle, sPn_desc[i].id, &param, dataLen);
+        if ((eCode == ECODE_NVM3_OK) && (param_store_set(i, &param) == 0))
+            found++;
+        nvm3_deleteObject(nvm3_defaultHandle, sPn_desc[i].id);
+    }
+    return found;
+}
+
+int param_nvm_load_all(void)
+{
+    int restored = 0;
+    for (int r=0; r<sPn_num_records; r++)
+    {
+        int rval = pn_read_record(r);
+        if (rval == cr_ErrorCodes_NO_ERROR)
+        {
+            restored++;
+            continue;
+        }
+        int migrated = (sPn_generation == 0) ? pn_migrate_legacy(r) : 0;
+        if (migrated > 0)
+        {
+            // The legacy objects are gone, so write the record now.
+            i3_log(LOG_MASK_ALWAYS, "Migrated %d params into NVM record %d.", migrated, r);
+            pn_write_record(r);
+            continue;
+        }
+        if (rval == cr_ErrorCodes_NO_DATA)
+            i3_log(LOG_MASK_ALWAYS, "Initializing NVM record %d.", r);
+        else
+            i3_log(LOG_MASK_WARN, "NVM record %d is stale, using defaults.", r);
+        // written by param_nvm_idle()
+        sPn_stale[r] = true;
+    }
+    return restored;
+}
+
+int param_nvm_save(int index)
+{
+    if ((index < 0) || (index >= sPn_count) || (sPn_record_of[index] == PN_NOT_NVM))
+    {
+        i3_log(LOG_MASK_ERROR, "%s: index %d is not stored in NVM.", __FUNCTION__, index);
+        return cr_ErrorCodes_INVALID_PARAMETER;
+    }
+    return pn_write_record(sPn_record_of[index]);
+}
+
+int param_nvm_factory_reset(void)
+{
+    uint32_t generation = sPn_generation + 1;
+    Ecode_t eCode = nvm3_writeData(nvm3_defaultHandle, PARAM_NVM_GENERATION_KEY,
+                                   &generation, sizeof(generation));
+    if (ECODE_NVM3_OK != eCode) {
+        i3_log(LOG_MASK_ERROR, "%s: NVM Write of generation failed with 0x%x.", 
+               __FUNCTION__, eCode);
+        return cr_ErrorCodes_WRITE_FAILED;
+    }
+    sPn_generation = generation;
+    pn_set_version();
+    for (int r=0; r<sPn_num_records; r++)
+        sPn_stale[r] = true;
+    i3_log(LOG_MASK_ALWAYS, "NVM parameters reset to generation %d.", sPn_generation);
+    return cr_ErrorCodes_NO_ERROR;
+}
+
+uint32_t param_nvm_count_boot(void)
+{
+    uint32_t boots = pn_read_counter(PARAM_NVM_BOOT_COUNT_KEY) + 1;
+    Ecode_t eCode = nvm3_writeData(nvm3_defaultHandle, PARAM_NVM_BOOT_COUNT_KEY,
+                                   &boots, sizeof(boots));
+    if (ECODE_NVM3_OK != eCode) {
+        i3_log(LOG_MASK_ERROR, "%s: NVM Write of boot count failed with 0x%x.", 
+               __FUNCTION__, eCode);
+    }
+    return boots;
+}
+
+bool param_nvm_idle(void)
+{
+    int r;
+    for (r=0; r<sPn_num_records; r++)
+    {
+        if (sPn_stale[r])
+            break;
+    }
+    if (r >= sPn_num_records)
+        return false;
+    pn_write_record(r);
+    // A failed write is not retried until the record is next saved.
+    sPn_stale[r] = false;
+    for (r++; r<sPn_num_records; r++)
+    {
+        if (sPn_stale[r])
+            return true;
+    }
+    return false;
+}
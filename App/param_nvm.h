@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2023-2024 i3 Product Development
+ * 
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/********************************************************************************************
+ *    _ ____  ___             _         _     ___              _                        _
+ *   (_)__ / | _ \_ _ ___  __| |_  _ __| |_  |   \ _____ _____| |___ _ __ _ __  ___ _ _| |_
+ *   | ||_ \ |  _/ '_/ _ \/ _` | || / _|  _| | |) / -_) V / -_) / _ \ '_ \ '  \/ -_) ' \  _|
+ *   |_|___/ |_| |_| \___/\__,_|\_,_\__|\__| |___/\___|\_/\___|_\___/ .__/_|_|_\___|_||_\__|
+ *                                                                  |_|
+ *                           -----------------------------------
+ *                          Copyright i3 Product Development 2023
+ * 
+ * \brief Stores parameter values in NVM as packed records.
+ *
+ ********************************************************************************************/
+
+/**
+ * @file      param_nvm.h
+ * @brief     Interface to the packed NVM records used by params.c.
+ * @copyright (c) Copyright 2023 i3 Product Development. All Rights Reserved.
+ * The Cygngus Reach firmware stack is shared under an MIT license.
+ */
+
+#ifndef _PARAM_NVM_H_
+#define _PARAM_NVM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "reach.pb.h"
+
+/// NVM3 key of the first record.  Records use consecutive keys.
+#define PARAM_NVM_RECORD_KEY_BASE   0x20000
+
+/// NVM3 key of the generation counter.  A factory reset advances it.
+#define PARAM_NVM_GENERATION_KEY    0x1FFFF
+
+/// NVM3 key of the boot count.
+#define PARAM_NVM_BOOT_COUNT_KEY    0x1FFFE
+
+/// Bytes per record, including the version.  
+/// Must not exceed NVM3_DEFAULT_MAX_OBJECT_SIZE.
+#ifndef PARAM_NVM_RECORD_SIZE
+  #define PARAM_NVM_RECORD_SIZE     240
+#endif
+
+/// The largest number of records.
+#ifndef PARAM_NVM_MAX_RECORDS
+  #define PARAM_NVM_MAX_RECORDS     16
+#endif
+
+/// Assigns the NONVOLATILE parameters to records.  Call after param_store_init().
+/// Returns zero or an error code.
+int param_nvm_init(const cr_ParameterInfo *desc, int count);
+
+/// Restores all NONVOLATILE parameters into the store, a record per read.
+/// Records that are missing or from a different layout are rebuilt from the
+/// values in the store.  Returns the number of records restored.
+int param_nvm_load_all(void);
+
+/// Writes the record holding the parameter, by index into the descriptions.
+int param_nvm_save(int index);
+
+/// Discards all stored values with a single small NVM write by advancing the
+/// generation.  Records of older generations are then ignored.  Call 
+/// init_param_repo() afterwards to restore the defaults.
+int param_nvm_factory_reset(void);
+
+/// Advances the boot count kept in NVM and returns it.  Call once at startup.
+uint32_t param_nvm_count_boot(void);
+
+/// Rewrites one record that is missing or from an older generation.  Call 
+/// when idle.  Returns true if more remain.
+bool param_nvm_idle(void);
+
+#endif  // ndef _PARAM_NVM_H_
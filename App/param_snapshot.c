@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2023-2024 i3 Product Development
+ * 
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/********************************************************************************************
+ *    _ ____  ___             _         _     ___              _                        _
+ *   (_)__ / | _ \_ _ ___  __| |_  _ __| |_  |   \ _____ _____| |___ _ __ _ __  ___ _ _| |_
+ *   | ||_ \ |  _/ '_/ _ \/ _` | || / _|  _| | |) / -_) V / -_) / _ \ '_ \ '  \/ -_) ' \  _|
+ *   |_|___/ |_| |_| \___/\__,_|\_,_\__|\__| |___/\___|\_/\___|_\___/ .__/_|_|_\___|_||_\__|
+ *                                                                  |_|
+ *                           -----------------------------------
+ *                          Copyright i3 Product Development 2023
+ * 
+ * \brief Serves the current parameter values as one file.
+ *
+ ********************************************************************************************/
+
+/**
+ * @file      param_snapshot.c
+ * @brief     An example of a bulk parameter read.  READ_PARAMETERS returns a
+ *            few values per message.  This file serializes the current value
+ *            of every parameter, or of a selected subset, into one compact 
+ *            blob that a client pulls with a single file transfer.  This file
+ *            is part of the application and NOT part of the core stack.
+ * @copyright (c) Copyright 2023 i3 Product Development. All Rights Reserved.
+ * The Cygngus Reach firmware stack is shared under an MIT license.
+ *
+ * The snapshot is taken into a RAM buffer when a transfer starts, so all 
+ * values come from the same moment and the reported size remains valid.
+ * If the buffer fills, the snapshot is truncated at an entry boundary and 
+ * flagged.  The client can then select the remaining parameters.
+ * 
+ * Selecting a subset:  Write the file with a list of PID ranges, each a pair
+ * of uint16 (first, last), inclusive.  A single parameter is a range with
+ * first == last.  The selection applies to later snapshots until it is 
+ * rewritten or the file is erased, which selects all parameters again.
+ * 
+ * File format, all little endian:
+ *   File header (12 bytes):
+ *     "RPS", uint8 format version, uint32 timestamp of the snapshot, 
+ *     uint16 number of entries, uint8 flags, uint8 reserved.
+ *     Flag bit 0 is set if the snapshot was truncated.
+ *     Flag bit 1 is set if a value was pending.
+ *   For each parameter, in discovery order:
+ *     uint16 parameter ID, uint8 cr_ParameterValue value tag, then the value.
+ *     A value that was not ready (cr_ErrorCodes_PENDING) has tag zero and no
+ *     value.  Its read has been started, so a later snapshot will hold it.
+ *       - 32 bit numeric, enum and bitfield types:  4 bytes.
+ *       - 64 bit numeric types:  8 bytes.
+ *       - bool:  1 byte.
+ *       - string and byte array:  uint8 length followed by the content.  
+ *         Strings are not terminated.
+ */
+
+#include "reach-server.h"  // configures Reach
+
+#ifdef INCLUDE_PARAM_SNAPSHOT
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "cr_stack.h"
+#include "i3_log.h"
+#include "param_snapshot.h"
+#include "param_store.h"
+
+#ifndef INCLUDE_FILE_SERVICE
+    #error "INCLUDE_PARAM_SNAPSHOT requires INCLUDE_FILE_SERVICE."
+#endif
+#ifndef INCLUDE_PARAMETER_SERVICE
+    #error "INCLUDE_PARAM_SNAPSHOT requires INCLUDE_PARAMETER_SERVICE."
+#endif
+
+#define PS_FORMAT_VERSION           2
+#define PS_FILE_HEADER_SIZE         12
+#define PS_ENTRY_HEADER_SIZE        3
+// The largest value is a string or byte array with its length byte.
+#define PS_MAX_VALUE_SIZE           (1 + REACH_PVAL_BYTES_LEN)
+#define PS_FLAG_TRUNCATED           0x01
+#define PS_FLAG_PENDING             0x02
+#define PS_RANGE_SIZE               4
+
+static uint8_t  sPs_buffer[PARAM_SNAPSHOT_BUFFER_SIZE];
+static uint32_t sPs_size = 0;
+
+// The selection is kept as written: pairs of uint16 (first, last).
+static uint8_t  sPs_selection[PARAM_SNAPSHOT_MAX_RANGES * PS_RANGE_SIZE];
+static uint32_t sPs_selection_bytes = 0;    // zero selects all
+
+static void ps_put(uint8_t *pDst, uint64_t val, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        pDst[i] = val & 0xFF;
+        val >>= 8;
+    }
+}
+
+static uint16_t ps_get_u16(const uint8_t *pSrc)
+{
+    return (uint16_t)(pSrc[0] | (pSrc[1] << 8));
+}
+
+static bool ps_is_selected(uint32_t pid)
+{
+    int num_ranges = sPs_selection_bytes / PS_RANGE_SIZE;
+    if (num_ranges == 0)
+        return true;
+
+    for (int i = 0; i < num_ranges; i++)
+    {
+        const uint8_t *range = &sPs_selection[i * PS_RANGE_SIZE];
+        if ((pid >= ps_get_u16(range)) && (pid <= ps_get_u16(range + 2)))
+            return true;
+    }
+    return false;
+}
+
+// Packs the value after the entry header.  Returns the bytes written or 
+// zero if the type is not known.
+static int ps_pack_value(const cr_ParameterValue *param, uint8_t *pDst)
+{
+    switch (param->which_value)
+    {
+    case cr_ParameterValue_uint32_value_tag:
+        ps_put(pDst, param->value.uint32_value, 4);
+        return 4;
+    case cr_ParameterValue_sint32_value_tag:
+        ps_put(pDst, (uint32_t)param->value.sint32_value, 4);
+        return 4;
+    case cr_ParameterValue_float32_value_tag:
+    {
+        uint32_t raw;
+        memcpy(&raw, &param->value.float32_value, sizeof(raw));
+        ps_put(pDst, raw, 4);
+        return 4;
+    }
+    case cr_ParameterValue_enum_value_tag:
+        ps_put(pDst, param->value.enum_value, 4);
+        return 4;
+    case cr_ParameterValue_bitfield_value_tag:
+        ps_put(pDst, param->value.bitfield_value, 4);
+        return 4;
+    case cr_ParameterValue_uint64_value_tag:
+        ps_put(pDst, param->value.uint64_value, 8);
+        return 8;
+    case cr_ParameterValue_sint64_value_tag:
+        ps_put(pDst, (uint64_t)param->value.sint64_value, 8);
+        return 8;
+    case cr_ParameterValue_float64_value_tag:
+    {
+        uint64_t raw;
+        memcpy(&raw, &param->value.float64_value, sizeof(raw));
+        ps_put(pDst, raw, 8);
+        return 8;
+    }
+    case cr_ParameterValue_bool_value_tag:
+        pDst[0] = param->value.bool_value ? 1 : 0;
+        return 1;
+    case cr_ParameterValue_string_value_tag:
+    {
+        size_t len = strnlen(param->value.string_value, REACH_PVAL_STRING_LEN);
+        pDst[0] = (uint8_t)len;
+        memcpy(&pDst[1], param->value.string_value, len);
+        return 1 + len;
+    }
+    case cr_ParameterValue_bytes_value_tag:
+    {
+        size_t len = param->value.bytes_value.size;
+        if (len > REACH_PVAL_BYTES_LEN)
+            len = REACH_PVAL_BYTES_LEN;
+        pDst[0] = (uint8_t)len;
+        memcpy(&pDst[1], param->value.bytes_value.bytes, len);
+        return 1 + len;
+    }
+    default:
+        break;
+    }
+    return 0;
+}
+
+void param_snapshot_take(uint32_t timestamp)
+{
+    uint16_t num_entries = 0;
+    uint8_t  flags = 0;
+    uint32_t size = PS_FILE_HEADER_SIZE;
+
+    // Walk the parameter table directly.  The discovery cursor belongs to 
+    // the protocol and a snapshot must not disturb a discovery in progress.
+    for (int i = 0; i < param_store_count(); i++)
+    {
+        const cr_ParameterInfo *desc = param_store_description(i);
+        if (!ps_is_selected(desc->id))
+            continue;
+
+        cr_ParameterValue param;
+        int rval = cr_parameter_read(desc->id, &param);
+        if (rval == cr_ErrorCodes_PENDING)
+        {
+            param.which_value = 0;  // an entry without a value
+            flags |= PS_FLAG_PENDING;
+        }
+        else if (rval != 0)
+        {
+            I3_LOG(LOG_MASK_WARN, "Param snapshot: read of PID %d failed, skipped.", desc->id);
+            continue;
+        }
+        if ((size + PS_ENTRY_HEADER_SIZE + PS_MAX_VALUE_SIZE) > sizeof(sPs_buffer))
+        {
+            i3_log(LOG_MASK_WARN, "Param snapshot truncated at PID %d.", desc->id);
+            flags |= PS_FLAG_TRUNCATED;
+            break;
+        }
+        uint8_t *pEntry = &sPs_buffer[size];
+        int len = 0;
+        if (param.which_value != 0)
+        {
+            len = ps_pack_value(&param, &pEntry[PS_ENTRY_HEADER_SIZE]);
+            if (len == 0)
+                continue;
+        }
+        ps_put(pEntry, desc->id, 2);
+        pEntry[2] = (uint8_t)param.which_value;
+        size += PS_ENTRY_HEADER_SIZE + len;
+        num_entries++;
+    }
+
+    memcpy(sPs_buffer, "RPS", 3);
+    sPs_buffer[3] = PS_FORMAT_VERSION;
+    ps_put(&sPs_buffer[4], timestamp, 4);
+    ps_put(&sPs_buffer[8], num_entries, 2);
+    sPs_buffer[10] = flags;
+    sPs_buffer[11] = 0;
+    sPs_size = size;
+    I3_LOG(LOG_MASK_FILES, "Param snapshot of %d parameters, %d bytes.", num_entries, sPs_size);
+}
+
+void param_snapshot_get_description(cr_FileInfo *file_desc)
+{
+    memset(file_desc, 0, sizeof(cr_FileInfo));
+    file_desc->file_id = PARAM_SNAPSHOT_FILE_ID;
+    strncpy(file_desc->file_name, "param_snapshot.bin", sizeof(file_desc->file_name));
+    file_desc->access = cr_AccessLevel_READ_WRITE;
+    file_desc->current_size_bytes = sPs_size;
+    file_desc->storage_location = cr_StorageLocation_RAM;
+}
+
+int param_snapshot_read(const int offset, const size_t bytes_requested,
+                        uint8_t *pData, int *bytes_read)
+{
+    if (sPs_size == 0)
+    {   // a read without a preceding description.
+        param_snapshot_take(cr_get_current_ticks());
+    }
+    if ((offset < 0) || ((uint32_t)offset >= sPs_size))
+    {
+        i3_log(LOG_MASK_ERROR, "%s: offset %d is beyond the snapshot size %d.",
+               __FUNCTION__, offset, sPs_size);
+        *bytes_read = 0;
+        return cr_ErrorCodes_INVALID_PARAMETER;
+    }
+
+    uint32_t end = offset + bytes_requested;
+    if (end > sPs_size)
+        end = sPs_size;
+    memcpy(pData, &sPs_buffer[offset], end - offset);
+    *bytes_read = end - offset;
+    return 0;
+}
+
+int param_snapshot_write(const int offset, const size_t bytes,
+                         const uint8_t *pData)
+{
+    if ((offset < 0) || ((offset + bytes) > sizeof(sPs_selection)))
+    {
+        i3_log(LOG_MASK_ERROR, "%s: A selection holds at most %d ranges.",
+               __FUNCTION__, PARAM_SNAPSHOT_MAX_RANGES);
+        return cr_ErrorCodes_NO_RESOURCE;
+    }
+    if (offset == 0)
+        sPs_selection_bytes = 0;    // a new selection
+
+    memcpy(&sPs_selection[offset], pData, bytes);
+    sPs_selection_bytes = offset + bytes;
+    return 0;
+}
+
+void param_snapshot_select_all(void)
+{
+    sPs_selection_bytes = 0;
+    I3_LOG(LOG_MASK_FILES, "Param snapshot selects all parameters.");
+}
+
+#endif  // def INCLUDE_PARAM_SNAPSHOT
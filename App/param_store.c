@@ -0,0 +1,457 @@
+/*
+ * Copyright (c) 2023-2024 i3 Product Development
+ * 
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/********************************************************************************************
+ *    _ ____  ___             _         _     ___              _                        _
+ *   (_)__ / | _ \_ _ ___  __| |_  _ __| |_  |   \ _____ _____| |___ _ __ _ __  ___ _ _| |_
+ *   | ||_ \ |  _/ '_/ _ \/ _` | || / _|  _| | |) / -_) V / -_) / _ \ '_ \ '  \/ -_) ' \  _|
+ *   |_|___/ |_| |_| \___/\__,_|\_,_\__|\__| |___/\___|\_/\___|_\___/ .__/_|_|_\___|_||_\__|
+ *                                                                  |_|
+ *                           -----------------------------------
+ *                          Copyright i3 Product Development 2023
+ * 
+ * \brief Compact, typed storage for parameter values.
+ *
+ ********************************************************************************************/
+
+/**
+ * @file      param_store.c
+ * @brief     Stores parameter values packed by type rather than as an array 
+ *            of cr_ParameterValue.  A cr_ParameterValue is sized for the 32 
+ *            byte string union, so each bool would otherwise cost as much as a
+ *            string.  This file is part of the application and NOT part of 
+ *            the core stack.
+ * @copyright (c) Copyright 2023 i3 Product Development. All Rights Reserved.
+ * The Cygngus Reach firmware stack is shared under an MIT license.
+ *
+ * The arena is laid out at init, in this order:
+ *   - 8 byte slots for UINT64, INT64 and FLOAT64.
+ *   - 4 byte slots for UINT32, INT32, FLOAT32, ENUMERATION and BIT_FIELD.
+ *   - A bit array for BOOL.
+ *   - Variable slots for STRING and BYTE_ARRAY.  The slot size is taken from
+ *     size_in_bytes, or the protobuf maximum when that is zero.  Byte arrays
+ *     are preceded by a length byte.
+ *   - Variable slots for LARGE_BYTES, size_in_bytes long and preceded by a 
+ *     two byte length.  These are accessed in parts by param_store_read_large()
+ *     and param_store_write_large().
+ * Each parameter costs a 2 byte offset and a 4 byte timestamp plus its slot.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "reach-server.h"  // configures Reach
+#include "cr_stack.h"
+#include "i3_log.h"
+#include "param_store.h"
+
+// 8 byte aligned so the 8 byte slots come first.
+static uint64_t sPs_arena[(PARAM_STORE_ARENA_SIZE + 7)/8];
+#define PS_ARENA_BYTES  ((uint8_t*)sPs_arena)
+
+static const cr_ParameterInfo *sPs_desc = NULL;
+static int      sPs_count = 0;
+static uint16_t sPs_bool_base = 0;          // byte offset of the bit array
+// Byte offset into the arena, or the bit index for bools.
+static uint16_t sPs_offset[PARAM_STORE_MAX_PARAMS];
+static uint32_t sPs_timestamp[PARAM_STORE_MAX_PARAMS];
+// A LARGE_BYTES value being written, by index, or -1.
+static uint8_t  sPs_stage[PARAM_STORE_LARGE_STAGE_SIZE];
+static int      sPs_stage_index = -1;
+
+// size of the slot holding a string or byte array
+static size_t ps_var_len(const cr_ParameterInfo *desc)
+{
+    if (desc->data_type == cr_ParameterDataType_LARGE_BYTES)
+    {
+        if (desc->size_in_bytes == 0)
+            return 2 + REACH_LARGE_PARAM_CHUNK_LEN;
+        return 2 + desc->size_in_bytes;
+    }
+    if (desc->data_type == cr_ParameterDataType_STRING)
+    {
+        if ((desc->size_in_bytes == 0) || (desc->size_in_bytes > REACH_PVAL_STRING_LEN))
+            return REACH_PVAL_STRING_LEN;
+        return desc->size_in_bytes;
+    }
+    if ((desc->size_in_bytes == 0) || (desc->size_in_bytes > REACH_PVAL_BYTES_LEN))
+        return 1 + REACH_PVAL_BYTES_LEN;
+    return 1 + desc->size_in_bytes;
+}
+
+// Returns the size of the fixed slot, 1 for bool, 0 for variable.
+static int ps_slot_size(cr_ParameterDataType data_type)
+{
+    switch (data_type)
+    {
+    case cr_ParameterDataType_UINT64:
+    case cr_ParameterDataType_INT64:
+    case cr_ParameterDataType_FLOAT64:
+        return 8;
+    case cr_ParameterDataType_UINT32:
+    case cr_ParameterDataType_INT32:
+    case cr_ParameterDataType_FLOAT32:
+    case cr_ParameterDataType_ENUMERATION:
+    case cr_ParameterDataType_BIT_FIELD:
+        return 4;
+    case cr_ParameterDataType_BOOL:
+        return 1;
+    default:
+        break;
+    }
+    return 0;
+}
+
+// The value tag matching a data type.  To match the apps and protobufs, 
+// must use _value_tags!
+static pb_size_t ps_tag(cr_ParameterDataType data_type)
+{
+    switch (data_type)
+    {
+    case cr_ParameterDataType_UINT32:      return cr_ParameterValue_uint32_value_tag;
+    case cr_ParameterDataType_INT32:       return cr_ParameterValue_sint32_value_tag;
+    case cr_ParameterDataType_FLOAT32:     return cr_ParameterValue_float32_value_tag;
+    case cr_ParameterDataType_UINT64:      return cr_ParameterValue_uint64_value_tag;
+    case cr_ParameterDataType_INT64:       return cr_ParameterValue_sint64_value_tag;
+    case cr_ParameterDataType_FLOAT64:     return cr_ParameterValue_float64_value_tag;
+    case cr_ParameterDataType_BOOL:        return cr_ParameterValue_bool_value_tag;
+    case cr_ParameterDataType_STRING:      return cr_ParameterValue_string_value_tag;
+    case cr_ParameterDataType_ENUMERATION: return cr_ParameterValue_enum_value_tag;
+    case cr_ParameterDataType_BIT_FIELD:   return cr_ParameterValue_bitfield_value_tag;
+    case cr_ParameterDataType_BYTE_ARRAY:  return cr_ParameterValue_bytes_value_tag;
+    case cr_ParameterDataType_LARGE_BYTES: return cr_ParameterValue_bytes_value_tag;
+    default:
+        break;
+    }
+    return 0;
+}
+
+int param_store_init(const cr_ParameterInfo *desc, int count)
+{
+    if (count > PARAM_STORE_MAX_PARAMS)
+    {
+        LOG_ERROR("%d parameters exceed PARAM_STORE_MAX_PARAMS (%d).", 
+                  count, PARAM_STORE_MAX_PARAMS);
+        return cr_ErrorCodes_NO_RESOURCE;
+    }
+
+    // count each class to find the start of each region
+    size_t num8 = 0, num4 = 0, numBool = 0, varBytes = 0;
+    for (int i=0; i<count; i++)
+    {
+        switch (ps_slot_size(desc[i].data_type))
+        {
+        case 8:  num8++;    break;
+        case 4:  num4++;    break;
+        case 1:  numBool++; break;
+        default: varBytes += ps_var_len(&desc[i]); break;
+        }
+        if ((desc[i].data_type == cr_ParameterDataType_LARGE_BYTES) &&
+            ((ps_var_len(&desc[i]) - 2) > PARAM_STORE_LARGE_STAGE_SIZE))
+        {
+            LOG_ERROR("Parameter %d exceeds PARAM_STORE_LARGE_STAGE_SIZE (%d).", 
+                      desc[i].id, PARAM_STORE_LARGE_STAGE_SIZE);
+            return cr_ErrorCodes_NO_RESOURCE;
+        }
+    }
+    size_t base4   = num8 * 8;
+    size_t baseB   = base4 + num4 * 4;
+    size_t baseVar = baseB + (numBool + 7)/8;
+    size_t total   = baseVar + varBytes;
+    if (total > PARAM_STORE_ARENA_SIZE)
+    {
+        LOG_ERROR("Parameter store needs %d bytes, PARAM_STORE_ARENA_SIZE is %d.",
+                  (int)total, PARAM_STORE_ARENA_SIZE);
+        return cr_ErrorCodes_NO_RESOURCE;
+    }
+
+    // assign the slots
+    size_t next8 = 0, next4 = base4, nextBit = 0, nextVar = baseVar;
+    for (int i=0; i<count; i++)
+    {
+        switch (ps_slot_size(desc[i].data_type))
+        {
+        case 8:
+            sPs_offset[i] = next8;
+            next8 += 8;
+            break;
+        case 4:
+            sPs_offset[i] = next4;
+            next4 += 4;
+            break;
+        case 1:
+            sPs_offset[i] = nextBit++;
+            break;
+        default:
+            sPs_offset[i] = nextVar;
+            nextVar += ps_var_len(&desc[i]);
+            break;
+        }
+    }
+
+    memset(sPs_arena, 0, sizeof(sPs_arena));
+    memset(sPs_timestamp, 0, sizeof(sPs_timestamp));
+    sPs_stage_index = -1;
+    sPs_bool_base = baseB;
+    sPs_desc = desc;
+    sPs_count = count;
+    I3_LOG(LOG_MASK_PARAMS, "Parameter store uses %d of %d bytes for %d params.",
+           (int)total, PARAM_STORE_ARENA_SIZE, count);
+    return 0;
+}
+
+int param_store_count(void)
+{
+    return sPs_count;
+}
+
+const cr_ParameterInfo *param_store_description(int index)
+{
+    if ((index < 0) || (index >= sPs_count))
+        return NULL;
+    return &sPs_desc[index];
+}
+
+int param_store_get(int index, cr_ParameterValue *data)
+{
+    if ((index < 0) || (index >= sPs_count))
+        return cr_ErrorCodes_INVALID_PARAMETER;
+
+    const cr_ParameterInfo *desc = &sPs_desc[index];
+    uint8_t *pSlot = &PS_ARENA_BYTES[sPs_offset[index]];
+
+    memset(data, 0, sizeof(cr_ParameterValue));
+    data->parameter_id = desc->id;
+    data->timestamp = sPs_timestamp[index];
+    data->which_value = ps_tag(desc->data_type);
+
+    // All of the union members start at the same address.
+    switch (desc->data_type)
+    {
+    case cr_ParameterDataType_BOOL:
+        pSlot = &PS_ARENA_BYTES[sPs_bool_base + sPs_offset[index]/8];
+        data->value.bool_value = (*pSlot >> (sPs_offset[index] % 8)) & 1;
+        break;
+    case cr_ParameterDataType_STRING:
+        memcpy(data->value.string_value, pSlot, ps_var_len(desc));
+        data->value.string_value[REACH_PVAL_STRING_LEN-1] = 0;
+        break;
+    case cr_ParameterDataType_BYTE_ARRAY:
+        data->value.bytes_value.size = pSlot[0];
+        memcpy(data->value.bytes_value.bytes, pSlot + 1, pSlot[0]);
+        break;
+    case cr_ParameterDataType_LARGE_BYTES:
+    {
+        // An ordinary read gives the first bytes.
+        size_t len = pSlot[0] | (pSlot[1] << 8);
+        if (len > REACH_PVAL_BYTES_LEN)
+            len = REACH_PVAL_BYTES_LEN;
+        data->value.bytes_value.size = len;
+        memcpy(data->value.bytes_value.bytes, pSlot + 2, len);
+        break;
+    }
+    default:
+        memcpy(&data->value, pSlot, ps_slot_size(desc->data_type));
+        break;
+    }
+    return 0;
+}
+
+int param_store_set(int index, const cr_ParameterValue *data)
+{
+    if ((index < 0) || (index >= sPs_count))
+        return cr_ErrorCodes_INVALID_PARAMETER;
+
+    const cr_ParameterInfo *desc = &sPs_desc[index];
+    uint8_t *pSlot = &PS_ARENA_BYTES[sPs_offset[index]];
+    int slot_size = ps_slot_size(desc->data_type);
+
+    // A value of another type is not converted.
+    if (data->which_value != ps_tag(desc->data_type))
+    {
+        LOG_ERROR("Parameter %d write which_value %d does not match type %d.", 
+                  desc->id, data->which_value, desc->data_type);
+        return cr_ErrorCodes_INVALID_PARAMETER;
+    }
+
+    switch (desc->data_type)
+    {
+    case cr_ParameterDataType_BOOL:
+        pSlot = &PS_ARENA_BYTES[sPs_bool_base + sPs_offset[index]/8];
+        if (data->value.bool_value)
+            *pSlot |= (1 << (sPs_offset[index] % 8));
+        else
+            *pSlot &= ~(1 << (sPs_offset[index] % 8));
+        break;
+    case cr_ParameterDataType_STRING:
+    {
+        size_t len = ps_var_len(desc);
+        memcpy(pSlot, data->value.string_value, len);
+        pSlot[len-1] = 0;
+        break;
+    }
+    case cr_ParameterDataType_BYTE_ARRAY:
+    {
+        size_t len = data->value.bytes_value.size;
+        if (len > ps_var_len(desc) - 1)
+        {
+            LOG_ERROR("Parameter write of bytes has invalid size %d > %d", 
+                      (int)len, (int)ps_var_len(desc) - 1);
+            len = ps_var_len(desc) - 1;
+        }
+        pSlot[0] = len;
+        memcpy(pSlot + 1, data->value.bytes_value.bytes, len);
+        break;
+    }
+    case cr_ParameterDataType_LARGE_BYTES:
+    {
+        // An ordinary write replaces the whole value with a short one.
+        size_t len = data->value.bytes_value.size;
+        if (len > ps_var_len(desc) - 2)
+            len = ps_var_len(desc) - 2;
+        pSlot[0] = len & 0xFF;
+        pSlot[1] = len >> 8;
+        memcpy(pSlot + 2, data->value.bytes_value.bytes, len);
+        break;
+    }
+    default:
+        memcpy(pSlot, &data->value, slot_size);
+        break;
+    }
+    sPs_timestamp[index] = data->timestamp;
+    return 0;
+}
+
+size_t param_store_packed_size(int index)
+{
+    if ((index < 0) || (index >= sPs_count))
+        return 0;
+    int slot_size = ps_slot_size(sPs_desc[index].data_type);
+    return (slot_size != 0) ? (size_t)slot_size : ps_var_len(&sPs_desc[index]);
+}
+
+size_t param_store_pack(int index, uint8_t *pDst)
+{
+    size_t len = param_store_packed_size(index);
+    if (len == 0)
+        return 0;
+
+    if (sPs_desc[index].data_type == cr_ParameterDataType_BOOL)
+    {
+        uint8_t bits = PS_ARENA_BYTES[sPs_bool_base + sPs_offset[index]/8];
+        *pDst = (bits >> (sPs_offset[index] % 8)) & 1;
+        return len;
+    }
+    memcpy(pDst, &PS_ARENA_BYTES[sPs_offset[index]], len);
+    return len;
+}
+
+int param_store_unpack(int index, const uint8_t *pSrc)
+{
+    size_t len = param_store_packed_size(index);
+    if (len == 0)
+        return cr_ErrorCodes_INVALID_PARAMETER;
+
+    switch (sPs_desc[index].data_type)
+    {
+    case cr_ParameterDataType_BOOL:
+    {
+        uint8_t *pBits = &PS_ARENA_BYTES[sPs_bool_base + sPs_offset[index]/8];
+        if (*pSrc)
+            *pBits |= (1 << (sPs_offset[index] % 8));
+        else
+            *pBits &= ~(1 << (sPs_offset[index] % 8));
+        return 0;
+    }
+    case cr_ParameterDataType_STRING:
+        memcpy(&PS_ARENA_BYTES[sPs_offset[index]], pSrc, len);
+        PS_ARENA_BYTES[sPs_offset[index] + len - 1] = 0;
+        return 0;
+    case cr_ParameterDataType_BYTE_ARRAY:
+        if (pSrc[0] > len - 1)
+            return cr_ErrorCodes_INVALID_PARAMETER;
+        break;
+    case cr_ParameterDataType_LARGE_BYTES:
+        if ((size_t)(pSrc[0] | (pSrc[1] << 8)) > len - 2)
+            return cr_ErrorCodes_INVALID_PARAMETER;
+        break;
+    default:
+        break;
+    }
+    memcpy(&PS_ARENA_BYTES[sPs_offset[index]], pSrc, len);
+    return 0;
+}
+
+int param_store_read_large(int index, uint32_t offset, uint8_t *pDst, 
+                           size_t *len, uint32_t *total_size)
+{
+    if ((index < 0) || (index >= sPs_count) ||
+        (sPs_desc[index].data_type != cr_ParameterDataType_LARGE_BYTES))
+        return cr_ErrorCodes_INVALID_PARAMETER;
+
+    uint8_t *pSlot = &PS_ARENA_BYTES[sPs_offset[index]];
+    uint32_t size = pSlot[0] | (pSlot[1] << 8);
+    *total_size = size;
+    if (offset > size)
+        return cr_ErrorCodes_INVALID_PARAMETER;
+    if (*len > (size - offset))
+        *len = size - offset;
+    memcpy(pDst, pSlot + 2 + offset, *len);
+    return 0;
+}
+
+int param_store_write_large(int index, uint32_t offset, const uint8_t *pSrc, 
+                            size_t len, uint32_t total_size)
+{
+    if ((index < 0) || (index >= sPs_count) ||
+        (sPs_desc[index].data_type != cr_ParameterDataType_LARGE_BYTES))
+        return cr_ErrorCodes_INVALID_PARAMETER;
+
+    const cr_ParameterInfo *desc = &sPs_desc[index];
+    if (total_size > ps_var_len(desc) - 2)
+    {
+        LOG_ERROR("Parameter %d large write of %d bytes exceeds %d.", 
+                  desc->id, (int)total_size, (int)ps_var_len(desc) - 2);
+        return cr_ErrorCodes_NO_RESOURCE;
+    }
+    if ((offset + len) > total_size)
+        return cr_ErrorCodes_INVALID_PARAMETER;
+
+    if (offset == 0)
+        sPs_stage_index = index;    // a new value, any other is abandoned
+    else if (sPs_stage_index != index)
+        return cr_ErrorCodes_INVALID_STATE;
+    memcpy(sPs_stage + offset, pSrc, len);
+    if ((offset + len) < total_size)
+        return 0;
+
+    // Complete.  Readers see the new value and size together.
+    uint8_t *pSlot = &PS_ARENA_BYTES[sPs_offset[index]];
+    pSlot[0] = total_size & 0xFF;
+    pSlot[1] = total_size >> 8;
+    memcpy(pSlot + 2, sPs_stage, total_size);
+    sPs_stage_index = -1;
+    return 0;
+}
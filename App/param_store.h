@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2023-2024 i3 Product Development
+ * 
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/********************************************************************************************
+ *    _ ____  ___             _         _     ___              _                        _
+ *   (_)__ / | _ \_ _ ___  __| |_  _ __| |_  |   \ _____ _____| |___ _ __ _ __  ___ _ _| |_
+ *   | ||_ \ |  _/ '_/ _ \/ _` | || / _|  _| | |) / -_) V / -_) / _ \ '_ \ '  \/ -_) ' \  _|
+ *   |_|___/ |_| |_| \___/\__,_|\_,_\__|\__| |___/\___|\_/\___|_\___/ .__/_|_|_\___|_||_\__|
+ *                                                                  |_|
+ *                           -----------------------------------
+ *                          Copyright i3 Product Development 2023
+ * 
+ * \brief Compact, typed storage for parameter values.
+ *
+ ********************************************************************************************/
+
+/**
+ * @file      param_store.h
+ * @brief     Interface to the packed parameter value store used by params.c.
+ * @copyright (c) Copyright 2023 i3 Product Development. All Rights Reserved.
+ * The Cygngus Reach firmware stack is shared under an MIT license.
+ */
+
+#ifndef _PARAM_STORE_H_
+#define _PARAM_STORE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "reach.pb.h"
+
+/// The largest number of parameters that can be stored.
+#ifndef PARAM_STORE_MAX_PARAMS
+  #define PARAM_STORE_MAX_PARAMS    64
+#endif
+
+/// Bytes available for packed values.  Init reports the bytes used.
+#ifndef PARAM_STORE_ARENA_SIZE
+  #define PARAM_STORE_ARENA_SIZE    512
+#endif
+
+/// A LARGE_BYTES write is received here and replaces the stored value when
+/// it is complete, so that a reader never sees a mix of old and new.  It 
+/// must hold the largest LARGE_BYTES value.
+#ifndef PARAM_STORE_LARGE_STAGE_SIZE
+  #define PARAM_STORE_LARGE_STAGE_SIZE  REACH_LARGE_PARAM_CHUNK_LEN
+#endif
+
+/// Lays out the store for the described parameters.  Values start at zero.
+/// The descriptions must remain valid, typically they are const in flash.
+/// Returns zero or an error code.
+int param_store_init(const cr_ParameterInfo *desc, int count);
+
+/// The number of parameters given to param_store_init().
+int param_store_count(void);
+
+/// The description of a parameter, by index.  NULL if out of range.
+/// Modules that list the parameters walk the table with these rather than 
+/// with the discovery callbacks, whose cursor belongs to the protocol.
+const cr_ParameterInfo *param_store_description(int index);
+
+/// Populates a parameter value from the store, by index into the descriptions.
+int param_store_get(int index, cr_ParameterValue *data);
+
+/// Stores a parameter value, by index into the descriptions.  
+/// The value must have the type given in the description.
+int param_store_set(int index, const cr_ParameterValue *data);
+
+/// The packed form of a value is its slot in the store, with a bool taking
+/// one byte.  It has a fixed size for each parameter, suitable for NVM.
+size_t param_store_packed_size(int index);
+
+/// Copies the packed form of a value to pDst.  Returns the bytes written.
+size_t param_store_pack(int index, uint8_t *pDst);
+
+/// Restores a value from its packed form.  Returns zero or an error code.
+int param_store_unpack(int index, const uint8_t *pSrc);
+
+/// Copies up to *len bytes of a LARGE_BYTES value, starting at offset.
+/// Sets *len to the bytes copied and *total_size to the size of the value.
+int param_store_read_large(int index, uint32_t offset, uint8_t *pDst, 
+                           size_t *len, uint32_t *total_size);
+
+/// Stores part of a LARGE_BYTES value of total_size bytes.  A part at offset 
+/// zero starts a new value.  The parts are staged and the stored value is
+/// replaced by the last one.  Returns cr_ErrorCodes_NO_RESOURCE if it won't
+/// fit, cr_ErrorCodes_INVALID_STATE for a part of no value being written.
+int param_store_write_large(int index, uint32_t offset, const uint8_t *pSrc, 
+                            size_t len, uint32_t total_size);
+
+#endif  // ndef _PARAM_STORE_H_
@@ -57,126 +57,168 @@
 #include <string.h>
 #include <assert.h>
 
-#include "nvm3_default.h"
-
 #include "cr_stack.h"
 #include "i3_log.h"
 #include "app_version.h"
 #include "reach_silabs.h"
 
 #include "sl_simple_led_instances.h"
+#include "param_store.h"
+#include "param_nvm.h"
+#include "param_db.h"
 
 #define MSG_BUFFER_SIZE	256
 
-// There are 35 params defined in the .c file.
+// There are 37 params defined in the .c file.
 // One is write only so it is not transmitted.
 // Set this to 34 to go over the 32 param request size.
 #ifndef SKIP_ENUMS
-  #define NUM_PARAMS      35
+  #define NUM_PARAMS      37
   #define NUM_EX_PARAMS   4
   // Variable data holding the parameter values.
   // The init function makes it valid.
   extern const cr_ParamExInfoResponse param_ex_desc[NUM_EX_PARAMS];
 #else
-    #define NUM_PARAMS      33
+    #define NUM_PARAMS      35
 #endif
 
 #define STACK_VERSION_PARAM_ID  23
 #define STACK_VERSION_INDEX     11
 #define PROTO_VERSION_PARAM_ID  25
 #define PROTO_VERSION_INDEX     12
+#define CALIBRATION_PARAM_ID    71
+#define SCALED_PARAM_ID         73
 
 // const data describing the parameters, defined below, to be stored in flash.
 extern const cr_ParameterInfo  param_desc[NUM_PARAMS];
 
-// Variable data holding the parameter values.
-// The init function makes it valid.
-static cr_ParameterValue sCr_param_val[NUM_PARAMS];
+// The parameter values are held in param_store.c, packed by type.
+// The init function makes them valid.
+static int find_param_index(const uint32_t pid);
+
+#if NUM_DERIVED_PARAMS != 0
+// The incrementing p69 scaled by the percentage in p5.
+static int compute_scaled(const uint32_t pid, const cr_ParameterValue *inputs,
+                          cr_ParameterValue *result)
+{
+    (void)pid;
+    result->which_value = cr_ParameterValue_float32_value_tag;
+    result->value.float32_value = 
+        inputs[0].value.sint32_value * inputs[1].value.float32_value / 100.0f;
+    return 0;
+}
 
-static int read_param_from_nvm(const uint32_t pid, cr_ParameterValue *param);
-static int write_param_to_nvm(const uint32_t pid, const cr_ParameterValue *param);
+// Parameters computed by the stack when read, rather than kept up to date here.
+#define NUM_DERIVED     1
+static const cr_DerivedParameter derived_params[NUM_DERIVED] = {
+    {
+        .pid =          SCALED_PARAM_ID,
+        .input_pids =   {69, 5},
+        .num_inputs =   2,
+        .compute =      compute_scaled
+    },
+};
+#endif  // NUM_DERIVED_PARAMS != 0
 
 void init_param_repo()
 {
     int rval = 0;
+    cr_ParameterValue val;
+
+    rval = param_store_init(param_desc, NUM_PARAMS);
+    affirm(rval == 0);
+    rval = param_nvm_init(param_desc, NUM_PARAMS);
+    affirm(rval == 0);
+  #ifdef INCLUDE_PARAM_DB
+    #ifndef SKIP_ENUMS
+    param_db_init(param_ex_desc, NUM_EX_PARAMS);
+    #else
+    param_db_init(NULL, 0);
+    #endif
+  #endif  // def INCLUDE_PARAM_DB
 
     // The data in this demo exercises all of the types.
     for (int i=0; i<NUM_PARAMS; i++)
     {
-        sCr_param_val[i].parameter_id = param_desc[i].id;
+        memset(&val, 0, sizeof(val));
+        val.parameter_id = param_desc[i].id;
 
         switch (param_desc[i].data_type)
         {
         case cr_ParameterDataType_UINT32: // pid 1, 23
-            sCr_param_val[i].value.uint32_value = 1984;
+            val.value.uint32_value = 1984;
             // To match the apps and protobufs, must use _value_tags!
-            sCr_param_val[i].which_value = cr_ParameterValue_uint32_value_tag;
+            val.which_value = cr_ParameterValue_uint32_value_tag;
             if (param_desc[i].has_default_value) 
-                sCr_param_val[i].value.uint32_value = (uint32_t)param_desc[i].default_value;
+                val.value.uint32_value = (uint32_t)param_desc[i].default_value;
             break;
         case cr_ParameterDataType_INT32: // pid 3, 25
-            sCr_param_val[i].value.sint32_value = -1999;
-            sCr_param_val[i].which_value = cr_ParameterValue_sint32_value_tag;
+            val.value.sint32_value = -1999;
+            val.which_value = cr_ParameterValue_sint32_value_tag;
             if (param_desc[i].has_default_value) 
-                sCr_param_val[i].value.sint32_value = (int32_t)param_desc[i].default_value;
+                val.value.sint32_value = (int32_t)param_desc[i].default_value;
             break;
         case cr_ParameterDataType_FLOAT32: // pid 5, 27
-            sCr_param_val[i].value.float32_value = 0.993;
-            sCr_param_val[i].which_value = cr_ParameterValue_float32_value_tag;
+            val.value.float32_value = 0.993;
+            val.which_value = cr_ParameterValue_float32_value_tag;
             if (param_desc[i].has_default_value) 
-                sCr_param_val[i].value.float32_value = (float)param_desc[i].default_value;
+                val.value.float32_value = (float)param_desc[i].default_value;
             break;
         case cr_ParameterDataType_UINT64:  // pid 7, 29
-            sCr_param_val[i].value.uint64_value = 441;
-            sCr_param_val[i].which_value = cr_ParameterValue_uint64_value_tag;
+            val.value.uint64_value = 441;
+            val.which_value = cr_ParameterValue_uint64_value_tag;
             if (param_desc[i].has_default_value) 
-                sCr_param_val[i].value.uint64_value = (uint64_t)param_desc[i].default_value;
+                val.value.uint64_value = (uint64_t)param_desc[i].default_value;
             break;
         case cr_ParameterDataType_INT64:  // pid 9
-            sCr_param_val[i].value.sint64_value = -10853;
-            sCr_param_val[i].which_value = cr_ParameterValue_sint64_value_tag;
+            val.value.sint64_value = -10853;
+            val.which_value = cr_ParameterValue_sint64_value_tag;
             if (param_desc[i].has_default_value) 
-                sCr_param_val[i].value.sint64_value = (int64_t)param_desc[i].default_value;
+                val.value.sint64_value = (int64_t)param_desc[i].default_value;
             break;
         case cr_ParameterDataType_FLOAT64:  // pid 11
-            sCr_param_val[i].value.float64_value = 0.51111111111;
-            sCr_param_val[i].which_value = cr_ParameterValue_float64_value_tag;
+            val.value.float64_value = 0.51111111111;
+            val.which_value = cr_ParameterValue_float64_value_tag;
             if (param_desc[i].has_default_value) 
-                sCr_param_val[i].value.float64_value = param_desc[i].default_value;
+                val.value.float64_value = param_desc[i].default_value;
             break;
         case cr_ParameterDataType_BOOL:  // pid 13
-            sCr_param_val[i].value.bool_value = true;
-            sCr_param_val[i].which_value = cr_ParameterValue_bool_value_tag;
+            val.value.bool_value = true;
+            val.which_value = cr_ParameterValue_bool_value_tag;
             if (param_desc[i].has_default_value) 
-                sCr_param_val[i].value.bool_value = param_desc[i].default_value;
+                val.value.bool_value = param_desc[i].default_value;
             break;
         case cr_ParameterDataType_STRING:  // pid 15
-            sprintf(sCr_param_val[i].value.string_value, "Flea bag");
-            sCr_param_val[i].which_value = cr_ParameterValue_string_value_tag;
+            sprintf(val.value.string_value, "Flea bag");
+            val.which_value = cr_ParameterValue_string_value_tag;
             break;
         case cr_ParameterDataType_ENUMERATION:  // 17
-            sCr_param_val[i].value.enum_value = 3;
-            sCr_param_val[i].which_value = cr_ParameterValue_enum_value_tag;
+            val.value.enum_value = 3;
+            val.which_value = cr_ParameterValue_enum_value_tag;
             if (param_desc[i].has_default_value) 
-                sCr_param_val[i].value.enum_value = param_desc[i].default_value;
+                val.value.enum_value = param_desc[i].default_value;
             break;
         case cr_ParameterDataType_BIT_FIELD:  // 19
-            sCr_param_val[i].value.bitfield_value = 0xDEAD;
-            sCr_param_val[i].which_value = cr_ParameterValue_bitfield_value_tag;
+            val.value.bitfield_value = 0xDEAD;
+            val.which_value = cr_ParameterValue_bitfield_value_tag;
             if (param_desc[i].has_default_value) 
-                sCr_param_val[i].value.bitfield_value = param_desc[i].default_value;
+                val.value.bitfield_value = param_desc[i].default_value;
             break;
         case cr_ParameterDataType_BYTE_ARRAY:  // 21
-            sprintf((char*)sCr_param_val[i].value.bytes_value.bytes, "a byte array");
-            sCr_param_val[i].value.bytes_value.size  = 13;
-            sCr_param_val[i].which_value = cr_ParameterValue_bytes_value_tag;
+            sprintf((char*)val.value.bytes_value.bytes, "a byte array");
+            val.value.bytes_value.size  = 13;
+            val.which_value = cr_ParameterValue_bytes_value_tag;
+            break;
+        case cr_ParameterDataType_LARGE_BYTES:  // 71
+            // Filled with a ramp below.
+            val.which_value = cr_ParameterValue_bytes_value_tag;
             break;
         default:
             affirm(0);  // should not happen.
             break;
         }  // end switch
 
-        // read any stored values from NVM
+        // check the storage location.  NVM is read in bulk below.
         switch (param_desc[i].storage_location) {
         default:
         case cr_StorageLocation_STORAGE_LOCATION_INVALID:
@@ -192,161 +234,200 @@ void init_param_repo()
             i3_log(LOG_MASK_ERROR, "At param index %d, NVM-EX not supported.", i);
             break;
         case cr_StorageLocation_NONVOLATILE:
-            rval = read_param_from_nvm(param_desc[i].id, &sCr_param_val[i]);
-            if (rval != 0) {
-                // first time initialize.
-                write_param_to_nvm(param_desc[i].id, &sCr_param_val[i]);
-                i3_log(LOG_MASK_ALWAYS, "Initialized pid %d in NVM.", param_desc[i].id);
-            }
             break;
         }
+        param_store_set(i, &val);
     } // end for
 
+    // Replace the defaults with any stored values.  
+    // Missing records are initialized from the defaults.
+    rval = param_nvm_load_all();
+    I3_LOG(LOG_MASK_PARAMS, "Restored %d NVM records.", rval);
+
     // the LED is an example of a parameter that connects to HW.
-    if (sCr_param_val[6].value.bool_value) 
+    param_store_get(6, &val);
+    if (val.value.bool_value) 
         sl_led_turn_on(SL_SIMPLE_LED_INSTANCE(0));
     else
         sl_led_turn_off(SL_SIMPLE_LED_INSTANCE(0));
 
     // copy the stack version into the parameter data.
     const char *pStackVer = cr_get_reach_version();
-    char *pVariableStackVer = sCr_param_val[STACK_VERSION_INDEX].value.string_value;
-    sprintf(pVariableStackVer, pStackVer, strlen(pStackVer));
+    param_store_get(STACK_VERSION_INDEX, &val);
+    snprintf(val.value.string_value, sizeof(val.value.string_value), "%s", pStackVer);
+    param_store_set(STACK_VERSION_INDEX, &val);
+
+    param_store_get(PROTO_VERSION_INDEX, &val);
+    val.value.uint32_value = cr_ReachProtoVersion_CURRENT_VERSION;
+    param_store_set(PROTO_VERSION_INDEX, &val);
+
+  #ifdef INCLUDE_LARGE_PARAMETERS
+    // fill the calibration table with a ramp so that chunks can be checked.
+    int cal = find_param_index(CALIBRATION_PARAM_ID);
+    uint8_t ramp[64];
+    for (uint32_t offset=0; offset<param_desc[cal].size_in_bytes; offset += sizeof(ramp))
+    {
+        for (size_t j=0; j<sizeof(ramp); j++)
+            ramp[j] = (uint8_t)(offset + j);
+        param_store_write_large(cal, offset, ramp, sizeof(ramp), 
+                                param_desc[cal].size_in_bytes);
+    }
+  #endif  // def INCLUDE_LARGE_PARAMETERS
 
-    sCr_param_val[PROTO_VERSION_INDEX].which_value = cr_ParameterValue_uint32_value_tag;
-    sCr_param_val[PROTO_VERSION_INDEX].value.uint32_value = cr_ReachProtoVersion_CURRENT_VERSION;
+  #if NUM_DERIVED_PARAMS != 0
+    // Also drops any values cached before a factory reset.
+    rval = cr_set_derived_parameters(derived_params, NUM_DERIVED);
+    affirm(rval == 0);
+  #endif  // NUM_DERIVED_PARAMS != 0
 }
 
+// Returns the index of the parameter, or -1 if not found.
+static int find_param_index(const uint32_t pid)
+{
+    for (int i=0; i<NUM_PARAMS; i++) {
+        if (param_desc[i].id == pid)
+            return i;
+    }
+    return -1;
+}
+
+#ifdef INCLUDE_PENDING_PARAM_READS
+// The incrementing parameter stands in for a sensor that needs a conversion
+// before it can be read.  A reconversion is needed once the value is stale.
+#define SLOW_PARAM_ID               69
+#define SLOW_PARAM_CONVERSION_MS    10
+#define SLOW_PARAM_FRESH_MS         100
+static bool sSlowParamConverting = false;
+static bool sSlowParamFresh = false;
+static uint32_t sSlowParamTicks = 0;
+
+// Called from the app loop to finish a conversion.
+static void slow_param_poll(uint32_t timestamp)
+{
+    if (sSlowParamFresh && ((timestamp - sSlowParamTicks) >= SLOW_PARAM_FRESH_MS))
+        sSlowParamFresh = false;
+    if (!sSlowParamConverting || ((timestamp - sSlowParamTicks) < SLOW_PARAM_CONVERSION_MS))
+        return;
+
+    cr_ParameterValue val;
+    param_store_get(find_param_index(SLOW_PARAM_ID), &val);
+    sSlowParamConverting = false;
+    sSlowParamFresh = true;
+    sSlowParamTicks = timestamp;
+    // Nothing may be waiting if this was started by a notification check.
+    cr_parameter_read_complete(SLOW_PARAM_ID, &val);
+}
+#endif  // def INCLUDE_PENDING_PARAM_READS
+
 // Populate a parameter value structure
 int crcb_parameter_read(const uint32_t pid, cr_ParameterValue *data)
 {
     affirm(data != NULL);
 
-    for (int i=0; i<NUM_PARAMS; i++) {
-        if (sCr_param_val[i].parameter_id == pid) {
-            *data = sCr_param_val[i];
-            // to do: write timestamp to be used in notification.
-            return 0;
+    int i = find_param_index(pid);
+    if (i < 0)
+        return cr_ErrorCodes_INVALID_PARAMETER;
+  #ifdef INCLUDE_PENDING_PARAM_READS
+    if ((pid == SLOW_PARAM_ID) && !sSlowParamFresh)
+    {
+        if (!sSlowParamConverting)
+        {
+            sSlowParamConverting = true;
+            sSlowParamTicks = cr_get_current_ticks();
         }
+        return cr_ErrorCodes_PENDING;
     }
-    return cr_ErrorCodes_INVALID_PARAMETER;
+  #endif  // def INCLUDE_PENDING_PARAM_READS
+    // to do: write timestamp to be used in notification.
+    return param_store_get(i, data);
 }
 
 int crcb_parameter_write(const uint32_t pid, const cr_ParameterValue *data)
 {
-    int rval = 0;
-    int pid_index;
+    int i = find_param_index(pid);
+    if (i < 0)
+        return cr_ErrorCodes_INVALID_PARAMETER;
 
-    for (int i=0; i<NUM_PARAMS; i++) {
-        if (sCr_param_val[i].parameter_id == pid) 
-        {
-            pid_index = i;
-            I3_LOG(LOG_MASK_PARAMS, "Write param[%d], pid %d (%d)", 
-                   i, pid, data->parameter_id);
-            I3_LOG(LOG_MASK_PARAMS, "  timestamp %d", data->timestamp);
-            I3_LOG(LOG_MASK_PARAMS, "  which %d", data->which_value);
-            sCr_param_val[i].timestamp = data->timestamp;
-            sCr_param_val[i].which_value = data->which_value;
-
-            switch (data->which_value)
-            {
-            // To match the apps and protobufs, must use _value_tags!
-            case cr_ParameterValue_uint32_value_tag:
-                sCr_param_val[i].value.uint32_value = data->value.uint32_value;
-                break;
-            case cr_ParameterValue_sint32_value_tag:
-                sCr_param_val[i].value.sint32_value = data->value.sint32_value;
-                break;
-            case cr_ParameterValue_float32_value_tag:
-                sCr_param_val[i].value.float32_value = data->value.float32_value;
-                break;
-            case cr_ParameterValue_uint64_value_tag:
-                sCr_param_val[i].value.uint64_value = data->value.uint64_value;
-                break;
-            case cr_ParameterValue_sint64_value_tag:
-                sCr_param_val[i].value.sint64_value = data->value.sint64_value;
-                break;
-            case cr_ParameterValue_float64_value_tag:
-                sCr_param_val[i].value.float64_value = data->value.float64_value;
-                break;
-            case cr_ParameterValue_bool_value_tag:
-                sCr_param_val[i].value.bool_value = data->value.bool_value;
-                break;
-            case cr_ParameterValue_string_value_tag:
-                memcpy(sCr_param_val[i].value.string_value,
-                       data->value.string_value, REACH_PVAL_STRING_LEN);
-                sCr_param_val[i].value.string_value[REACH_PVAL_STRING_LEN-1] = 0;
-                I3_LOG(LOG_MASK_PARAMS, "String value: %s",
-                       sCr_param_val[i].value.string_value);
-                break;
-            case cr_ParameterValue_bitfield_value_tag:
-                sCr_param_val[i].value.bitfield_value = data->value.bitfield_value;
-                break;
-            case cr_ParameterValue_enum_value_tag:
-                sCr_param_val[i].value.enum_value = data->value.enum_value;
-                break;
-            case cr_ParameterValue_bytes_value_tag:
-                memcpy(sCr_param_val[i].value.bytes_value.bytes, 
-                       data->value.bytes_value.bytes, 
-                       REACH_PVAL_BYTES_LEN);
-                if (data->value.bytes_value.size > REACH_PVAL_BYTES_LEN)
-                {
-                    LOG_ERROR("Parameter write of bytes has invalide size %d > %d", 
-                              data->value.bytes_value.size, REACH_PVAL_BYTES_LEN);
-                    sCr_param_val[i].value.bytes_value.size = REACH_PVAL_BYTES_LEN;
-                }
-                else
-                {
-                    sCr_param_val[i].value.bytes_value.size = data->value.bytes_value.size;
-                }
-                LOG_DUMP_MASK(LOG_MASK_PARAMS, "bytes value",
-                              sCr_param_val[i].value.bytes_value.bytes,
-                              sCr_param_val[i].value.bytes_value.size);
-                break;
-            default:
-                LOG_ERROR("Parameter write which_value %d not recognized.", 
-                              data->which_value);
-                rval = 1;
-                break;
-            }  // end switch
-
-            // act on specific writes
-            if (pid == 13) {
-                // bool controls LED.
-                if (sCr_param_val[pid_index].value.bool_value)
-                    sl_led_turn_on(SL_SIMPLE_LED_INSTANCE(0));
-                else
-                    sl_led_turn_off(SL_SIMPLE_LED_INSTANCE(0));
-            }
-
-            if (rval == 0) {
-
-                // Store to NVM if appropriate
-                switch (param_desc[i].storage_location) {
-                default:
-                case cr_StorageLocation_STORAGE_LOCATION_INVALID:
-                    i3_log(LOG_MASK_ERROR, "%s: At param index %d, invalid storage location %d.",
-                           __FUNCTION__, i, param_desc[i].storage_location);
-                    break;
-                case cr_StorageLocation_RAM:
-                case cr_StorageLocation_RAM_EXTENDED:
-                    break;  // no need to read
-                case cr_StorageLocation_NONVOLATILE_EXTENDED:
-                    // cr_StorageLocation_NONVOLATILE_EXTENDED is intended to 
-                    // support a system with more than one NVM region. 
-                    i3_log(LOG_MASK_ERROR, "%s: At param index %d, NVM-EX not supported.", __FUNCTION__, i);
-                    break;
-                case cr_StorageLocation_NONVOLATILE:
-                    write_param_to_nvm(param_desc[i].id, &sCr_param_val[i]);
-                    break;
-                }
-            }
-            return 0;
-        } // end if PID matches.
+    I3_LOG(LOG_MASK_PARAMS, "Write param[%d], pid %d (%d)", 
+           i, pid, data->parameter_id);
+    I3_LOG(LOG_MASK_PARAMS, "  timestamp %d", data->timestamp);
+    I3_LOG(LOG_MASK_PARAMS, "  which %d", data->which_value);
+
+    // The store checks the type against the description.
+    int rval = param_store_set(i, data);
+    if (rval != 0)
+        return rval;
+
+    cr_ParameterValue stored;
+    param_store_get(i, &stored);
+    switch (stored.which_value)
+    {
+    case cr_ParameterValue_string_value_tag:
+        I3_LOG(LOG_MASK_PARAMS, "String value: %s", stored.value.string_value);
+        break;
+    case cr_ParameterValue_bytes_value_tag:
+        LOG_DUMP_MASK(LOG_MASK_PARAMS, "bytes value",
+                      stored.value.bytes_value.bytes,
+                      stored.value.bytes_value.size);
+        break;
+    default:
+        break;
     }
-    // exited the for loop without finding a match.
-    return cr_ErrorCodes_INVALID_PARAMETER;
+
+    // act on specific writes
+    if (pid == 13) {
+        // bool controls LED.
+        if (stored.value.bool_value)
+            sl_led_turn_on(SL_SIMPLE_LED_INSTANCE(0));
+        else
+            sl_led_turn_off(SL_SIMPLE_LED_INSTANCE(0));
+    }
+
+    // Store to NVM if appropriate
+    switch (param_desc[i].storage_location) {
+    default:
+    case cr_StorageLocation_STORAGE_LOCATION_INVALID:
+        i3_log(LOG_MASK_ERROR, "%s: At param index %d, invalid storage location %d.",
+               __FUNCTION__, i, param_desc[i].storage_location);
+        break;
+    case cr_StorageLocation_RAM:
+    case cr_StorageLocation_RAM_EXTENDED:
+        break;  // no need to read
+    case cr_StorageLocation_NONVOLATILE_EXTENDED:
+        // cr_StorageLocation_NONVOLATILE_EXTENDED is intended to 
+        // support a system with more than one NVM region. 
+        i3_log(LOG_MASK_ERROR, "%s: At param index %d, NVM-EX not supported.", __FUNCTION__, i);
+        break;
+    case cr_StorageLocation_NONVOLATILE:
+        param_nvm_save(i);
+        break;
+    }
+    return 0;
+}
+
+#ifdef INCLUDE_LARGE_PARAMETERS
+int crcb_parameter_read_large(const uint32_t pid, uint32_t offset, 
+                              uint8_t *data, size_t *len, uint32_t *total_size)
+{
+    int i = find_param_index(pid);
+    if (i < 0)
+        return cr_ErrorCodes_INVALID_PARAMETER;
+    return param_store_read_large(i, offset, data, len, total_size);
+}
+
+int crcb_parameter_write_large(const uint32_t pid, uint32_t offset, 
+                               const uint8_t *data, size_t len, uint32_t total_size)
+{
+    int i = find_param_index(pid);
+    if (i < 0)
+        return cr_ErrorCodes_INVALID_PARAMETER;
+
+    I3_LOG(LOG_MASK_PARAMS, "Write large param[%d], pid %d, %d bytes at %d of %d", 
+           i, pid, (int)len, offset, total_size);
+    // Large values live in RAM, they don't fit an NVM record.
+    return param_store_write_large(i, offset, data, len, total_size);
 }
+#endif  // def INCLUDE_LARGE_PARAMETERS
 
 // return a number that changes if the parameter descriptions have changed.
 // The client can cache the parameter descriptions based on this hash.
@@ -379,6 +460,17 @@ uint32_t crcb_compute_parameter_hash(void)
     return hash;
 }
 
+// Named groups let a client read or discover a set of parameters in one 
+// request.  This demo groups parameters by their storage and access.
+bool crcb_parameter_is_in_group(const char *group_name, const cr_ParameterInfo *pDesc)
+{
+    if (!strcmp(group_name, "nvm"))
+        return pDesc->storage_location == cr_StorageLocation_NONVOLATILE;
+    if (!strcmp(group_name, "ro"))
+        return pDesc->access == cr_AccessLevel_READ;
+    return false;
+}
+
 
 // overriding the weak implemetation, this reports on our local repo.
 // Gets a pointer to this parameter description.
@@ -418,6 +510,25 @@ int crcb_parameter_discover_next(cr_ParameterInfo *pDesc)
     return rval;
 }
 
+#ifdef INCLUDE_PARAM_DESCRIPTION_PTR
+// The descriptions are const, so the stack can encode them in place.
+const cr_ParameterInfo *crcb_parameter_get_description_ptr(const uint32_t pid)
+{
+    int i = find_param_index(pid);
+    if (i < 0)
+        return NULL;
+    return &param_desc[i];
+}
+
+// The pointer form of crcb_parameter_discover_next().
+const cr_ParameterInfo *crcb_parameter_discover_next_ptr(void)
+{
+    if (sCurrentParameter >= NUM_PARAMS)
+        return NULL;
+    return &param_desc[sCurrentParameter++];
+}
+#endif  // def INCLUDE_PARAM_DESCRIPTION_PTR
+
 int crcb_parameter_get_count()
 {
     return NUM_PARAMS;
@@ -511,85 +622,23 @@ int crcb_parameter_ex_discover_next(cr_ParamExInfoResponse *pDesc)
 static uint32_t sLastChanged = 0;
 void generate_data_for_notify(uint32_t timestamp)
 {
+  #ifdef INCLUDE_PENDING_PARAM_READS
+    slow_param_poll(timestamp);
+  #endif  // def INCLUDE_PENDING_PARAM_READS
     uint32_t delta = timestamp - sLastChanged;
     if (delta < SYS_TICK_RATE)
         return;   // this parameter changes once per second.
-    sCr_param_val[34].value.sint32_value++;
-    sCr_param_val[34].timestamp = timestamp;
+    cr_ParameterValue val;
+    param_store_get(34, &val);
+    val.value.sint32_value++;
+    val.timestamp = timestamp;
+    param_store_set(34, &val);
+    // so that a reconnecting client reads it.
+    cr_parameter_changed(param_desc[34].id);
     sLastChanged = timestamp;
 
 }
 
-static int read_param_from_nvm(const uint32_t pid, cr_ParameterValue *param)
-{
-    int key = -1;
-    size_t dataLen;
-    uint32_t objectType;
-
-    for (int i=0; i<NUM_PARAMS; i++) {
-        if (sCr_param_val[i].parameter_id == pid) 
-        {
-            key = pid;
-            break;
-        }
-    }
-    if (key <0) {
-        i3_log(LOG_MASK_ERROR, "%s: Requested PID %d not found.", __FUNCTION__, pid);
-        return cr_ErrorCodes_INVALID_PARAMETER;
-    }
-
-    nvm3_getObjectInfo(nvm3_defaultHandle, key, &objectType, &dataLen);
-    if (objectType != NVM3_OBJECTTYPE_DATA) {
-        i3_log(LOG_MASK_WARN, "%s: Requested PID %d not in NVM.", 
-               __FUNCTION__, pid);
-        return cr_ErrorCodes_READ_FAILED;
-    }
-
-    Ecode_t eCode = nvm3_readData(nvm3_defaultHandle, key, (uint8_t*)param, dataLen);
-    if (ECODE_NVM3_OK != eCode) {
-        i3_log(LOG_MASK_ERROR, "%s: NVM Read of PID %d failed with 0x%x.", 
-               __FUNCTION__, pid, eCode);
-        return cr_ErrorCodes_READ_FAILED;
-    }
-    return cr_ErrorCodes_NO_ERROR;
-}
-
-static int write_param_to_nvm(const uint32_t pid, const cr_ParameterValue *param)
-{
-    int key = -1;
-
-    for (int i=0; i<NUM_PARAMS; i++) {
-        if (sCr_param_val[i].parameter_id == pid) 
-        {
-            key = i;
-            break;
-        }
-    }
-    if (key <0) {
-        i3_log(LOG_MASK_ERROR, "%s: PID %d not found.", __FUNCTION__, pid);
-        return cr_ErrorCodes_INVALID_PARAMETER;
-    }
-
-    Ecode_t eCode = nvm3_writeData(nvm3_defaultHandle, pid,
-                                   (uint8_t*)param, sizeof(cr_ParameterValue));
-    if (ECODE_NVM3_OK != eCode) {
-        i3_log(LOG_MASK_ERROR, "%s: NVM Write of PID %d failed with 0x%x.", 
-               __FUNCTION__, pid, eCode);
-        return cr_ErrorCodes_READ_FAILED;
-    }
-
-    // Do repacking if needed
-    if (nvm3_repackNeeded(nvm3_defaultHandle)) {
-        i3_log(LOG_MASK_ALWAYS, "Repacking NVM");
-        eCode = nvm3_repack(nvm3_defaultHandle);
-        if (eCode != ECODE_NVM3_OK) {
-            i3_log(LOG_MASK_ERROR, "%s: Error 0x%x repacking", __FUNCTION__, eCode);
-        }
-    }
-    I3_LOG(LOG_MASK_REACH, "Wrote PID %d (index %d) to NVM", pid, key);
-    return cr_ErrorCodes_NO_ERROR;
-}
-
 // ***********************************************************************************
 // Constant parameter descriptions:
 // ***********************************************************************************
@@ -1228,6 +1277,42 @@ const cr_ParameterInfo  param_desc[NUM_PARAMS] = {
         .default_value =    1,
         .storage_location = cr_StorageLocation_RAM
     },
+    // Too large for one message, read and written in chunks.
+    { // [35]
+        .id =               CALIBRATION_PARAM_ID,
+        .data_type =        cr_ParameterDataType_LARGE_BYTES,
+        .size_in_bytes  =   1024,
+        .name =             "Calibration table",
+        .access =           cr_AccessLevel_READ_WRITE,
+        .description =      "1 KB, chunked",
+        .units =            "",
+        .has_description =  true,
+        .has_range_min =    false,
+        .has_range_max =    false,
+        .has_default_value = false,
+        .range_min =        0,
+        .range_max =        0,
+        .default_value =    0,
+        .storage_location = cr_StorageLocation_RAM
+    },
+    // Derived, computed by the stack from p69 and p5.
+    { // [36]
+        .id =               SCALED_PARAM_ID,
+        .data_type =        cr_ParameterDataType_FLOAT32,
+        .size_in_bytes  =   0,
+        .name =             "p69 scaled by p5",
+        .access =           cr_AccessLevel_READ,
+        .description =      "Derived, p69*p5/100",
+        .units =            "",
+        .has_description =  true,
+        .has_range_min =    false,
+        .has_range_max =    false,
+        .has_default_value = false,
+        .range_min =        0,
+        .range_max =        0,
+        .default_value =    0,
+        .storage_location = cr_StorageLocation_RAM
+    },
 };
 
 #ifndef SKIP_ENUMS
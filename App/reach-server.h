@@ -49,13 +49,145 @@
 /// list of parameters.
 /// #define APP_REQUIRED_PARAMETER_KEY  0x9080706
 
+/// Define this if the app provides crcb_parameter_get_description_ptr() and 
+/// crcb_parameter_discover_next_ptr().  Parameter descriptions are then 
+/// encoded from the app's table instead of being copied.
+#define INCLUDE_PARAM_DESCRIPTION_PTR
+
 /// Setting this to zero removes support for unpolled parameter change notification
 /// Defines the size of the array holding param notification specifications.
 #define NUM_SUPPORTED_PARAM_NOTIFY  8
 
+/// Parameter writes flagged write_without_response are held here until the 
+/// stack is idle, keeping only the latest value for each parameter.
+/// Setting this to zero applies them immediately.
+#define NUM_PENDING_PARAM_WRITES    4
+
+/// Define this to allow crcb_parameter_read() to return cr_ErrorCodes_PENDING
+/// for a slow parameter and supply it later with cr_parameter_read_complete().
+/// The read response is held, other prompts are served, and it is sent when 
+/// all of its values have arrived.  Parameter discovery and reads are refused
+/// while a read is held.
+#define INCLUDE_PENDING_PARAM_READS
+/// A held read response is abandoned with an error report after this long.
+#define PENDING_PARAM_READ_TIMEOUT_MS   250
+
+/// The number of parameter changes remembered so that a reconnecting client 
+/// can read only what changed.  Setting this to zero removes the journal.
+/// It cannot exceed REACH_COUNT_PARAMS_IN_REQUEST.
+#define PARAM_JOURNAL_SIZE          32
+
+/// The number of derived parameters, computed from others only when read 
+/// and cached until an input changes.  See cr_set_derived_parameters().
+/// Setting this to zero removes support.
+#define NUM_DERIVED_PARAMS          4
+
+/// Define this to let a client that reconnects keep the notifications it
+/// configured.  Device info gives the client a session token.  If it presents
+/// the token at its next device info request, within the timeout, its 
+/// notifications continue.  Otherwise they are cleared as usual.
+#define INCLUDE_SESSION_RESUME
+/// A session can be resumed for this long after the link drops.
+#define SESSION_RESUME_TIMEOUT_MS       30000
+
+/// Define this to support LARGE_BYTES parameters.  Values up to a few KB are
+/// read and written in chunks, with parameter semantics and without opening
+/// a file transfer.
+#define INCLUDE_LARGE_PARAMETERS
+#ifdef INCLUDE_LARGE_PARAMETERS
+  /// The demo calibration table needs more room in the parameter store.
+  #define PARAM_STORE_ARENA_SIZE        1536
+  /// and a staging buffer that holds it while it is written.
+  #define PARAM_STORE_LARGE_STAGE_SIZE  1024
+#endif
+
 /// Define this to include support for the file service.
 #define INCLUDE_FILE_SERVICE
 
+/// The number of file transfers that can be open at once, each with its own 
+/// state and watchdog.  A log can then be read during an OTA upload.  The 
+/// packets of concurrent reads take turns.
+#define NUM_FILE_TRANSFERS          2
+
+/// A file write with selective_ack holds messages that arrive ahead of a 
+/// lost one in this many reorder slots, each the size of a file packet.
+/// Setting this to zero removes support for selective acknowledgement.
+#define NUM_FILE_REORDER_SLOTS      4
+
+/// Define this to gather file writes into whole flash pages.  crcb_write_file()
+/// is then given page aligned writes of this size, except at the start and end
+/// of a transfer.  Two buffers of this size are allocated so that the app can 
+/// program one while the other fills.  Set it to the flash page size.
+#define FILE_WRITE_PAGE_SIZE        2048
+
+/// During a file read, this many packets are read ahead from the file while 
+/// the stack is idle, so that sending a packet only copies its data.
+/// Setting this to zero removes the read ahead buffer.
+#define FILE_READ_AHEAD_PACKETS     4
+
+/// Define this to send file reads straight from files that are mapped in 
+/// memory, as given by crcb_file_get_mapped_data().  The data is then copied
+/// once, into the encoded message.  Other files use crcb_read_file().
+#define INCLUDE_FILE_MAPPED_READS
+
+/// Define this to let a client ask for file reads to be LZSS compressed.
+/// The compressor takes about 3.5 KB of RAM.  Text such as logs shrinks the 
+/// most.  There is one compressor, so a second compressed read is refused.
+#define INCLUDE_FILE_COMPRESSION
+
+/// Define this to let a client resume a file write after a disconnect.  The
+/// stack keeps a checkpoint of the data committed to crcb_write_file().  The
+/// app can keep it over a reset with crcb_file_save_checkpoint().
+#define INCLUDE_FILE_RESUME
+
+/// Define this to let a client ask for messages_per_ack to be tuned during a
+/// file write.  The rate grows while windows arrive whole and is halved on a
+/// loss.  Each ACK gives the rate to use next.
+#define INCLUDE_ADAPTIVE_ACK_RATE
+#ifdef INCLUDE_ADAPTIVE_ACK_RATE
+  #define ADAPTIVE_ACK_RATE_MIN       2
+  /// With selective_ack the rate cannot exceed 32.
+  #define ADAPTIVE_ACK_RATE_MAX       32
+#endif
+
+/// Define this to record a compressed history of selected parameters in RAM,
+/// exposed as a read-only file.  Requires the file service.  
+/// The recorded parameters are listed in param_history.c.
+#define INCLUDE_PARAM_HISTORY
+#ifdef INCLUDE_PARAM_HISTORY
+  /// The file ID under which the history is exposed.
+  #define PARAM_HISTORY_FILE_ID             2
+  /// Each recorded parameter owns this many blocks.  The oldest is discarded.
+  #define PARAM_HISTORY_BLOCKS_PER_PID      16
+  /// Bytes of compressed samples per block.  Steady samples take 2 to 3 bytes.
+  #define PARAM_HISTORY_BLOCK_SIZE          128
+  /// Sampling period in milliseconds, unless overridden in param_history.c.
+  #define PARAM_HISTORY_DEFAULT_PERIOD_MS   5000
+#endif
+
+/// Define this to serve the current values of all parameters as one file.
+/// A client selects a subset by writing a list of PID ranges to the file.
+/// Requires the file service.
+#define INCLUDE_PARAM_SNAPSHOT
+#ifdef INCLUDE_PARAM_SNAPSHOT
+  /// The file ID under which the snapshot is exposed.
+  #define PARAM_SNAPSHOT_FILE_ID            3
+  /// The snapshot is taken into this RAM buffer.  Larger sets are truncated.
+  #define PARAM_SNAPSHOT_BUFFER_SIZE        1024
+  /// The number of PID ranges a client can select.
+  #define PARAM_SNAPSHOT_MAX_RANGES         8
+#endif
+
+/// Define this to serve all parameter and extended descriptions as one 
+/// read-only file, tagged with the parameter metadata hash.  A client that
+/// misses its cache can fetch them with one transfer.  Requires the file 
+/// service.
+#define INCLUDE_PARAM_DB
+#ifdef INCLUDE_PARAM_DB
+  /// The file ID under which the description database is exposed.
+  #define PARAM_DB_FILE_ID                  4
+#endif
+
 /// Define this to support the remote CLI service.
 #define INCLUDE_CLI_SERVICE
 #ifdef INCLUDE_CLI_SERVICE
@@ -63,6 +63,7 @@
 #include "em_cmu.h"
 #include "gatt_db.h"
 #include "nvm3_default.h"
+#include "param_nvm.h"
 #include "app.h"
 
 static uint8_t  sRsl_ble_connection = 0;
@@ -130,6 +131,13 @@ void rsl_init()
     // Local init to emulate a parameter respository
     extern void init_param_repo();
     init_param_repo();
+    // A client's journal sequence from an earlier boot must not be taken
+    // as one of this boot, so each boot starts a new range.
+    cr_parameter_journal_restart(param_nvm_count_boot() << 16);
+  #ifdef INCLUDE_PARAM_HISTORY
+    extern void param_history_init(void);
+    param_history_init();
+  #endif  // def INCLUDE_PARAM_HISTORY
 
     I3_LOG(LOG_MASK_ALWAYS, "Enter 'help' to see available commands.");
 }
@@ -309,6 +317,12 @@ void rsl_app_process_action(void)
 
     uint32_t timestamp = time_since_startup * UPDATE_APP_TIMER_MS;
     generate_data_for_notify(timestamp);
+  #ifdef INCLUDE_PARAM_HISTORY
+    extern void param_history_sample(uint32_t timestamp);
+    param_history_sample(timestamp);
+  #endif  // def INCLUDE_PARAM_HISTORY
+    // rewrites NVM records left stale by a factory reset, one at a time.
+    param_nvm_idle();
     // process reach stack
     cr_process(timestamp);
 }
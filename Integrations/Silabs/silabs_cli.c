@@ -59,6 +59,7 @@
 #include "app_version.h"
 #include "cr_stack.h"
 #include "reach_silabs.h"
+#include "param_nvm.h"
 
 
 /******************************************************************************
@@ -215,6 +216,7 @@ else {
         Ecode_t eCode = nvm3_eraseAll(nvm3_defaultHandle);
         i3_log(LOG_MASK_ALWAYS, "nvm3_eraseAll() returned 0x%x", eCode);
         init_param_repo();
+        cr_parameter_journal_restart(0);
         return;
     }
 
@@ -252,6 +254,17 @@ else {
         if ((objectType == NVM3_OBJECTTYPE_DATA) && (dataLen > 0)) i3_log(LOG_MASK_ALWAYS, " Key %d is present, size %d.", keyList[0], dataLen);
     }
 
+    // packed parameter records
+    numObj = nvm3_enumObjects(nvm3_defaultHandle, keyList, NUM_KEYS, PARAM_NVM_RECORD_KEY_BASE, 
+                              PARAM_NVM_RECORD_KEY_BASE + PARAM_NVM_MAX_RECORDS - 1);
+    for (size_t i = 0; i < numObj; i++) {
+        size_t dataLen;
+        uint32_t objectType;
+
+        nvm3_getObjectInfo(nvm3_defaultHandle, keyList[i], &objectType, &dataLen);
+        i3_log(LOG_MASK_ALWAYS, " Param record 0x%x is present, size %d.", keyList[i], dataLen);
+    }
+
     return;
 }
 
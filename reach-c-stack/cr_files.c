@@ -141,19 +141,831 @@ typedef struct _cr_FileTransferStateMachine {
     uint32_t                transfer_length;    // requested at init
     uint8_t                 read_write;         // 0: read, 1: write.
     uint32_t                message_number;     // rolling counter
-    int32_t                 crc32;
+    uint32_t                crc32;              // of all data so far
+    bool                    has_expected_crc32; // given at init for a write
+    uint32_t                expected_crc32;
     uint32_t                messages_per_ack;   // target, fixed
     uint32_t                messages_until_ack; // current, counts down
     uint32_t                bytes_transfered;   // to date
+    bool                    selective_ack;      // granted at init for a write
+    uint32_t                window_length;      // messages in this window
+    uint32_t                received_map;       // bit n-1: message n arrived
+    uint32_t                ack_trigger;        // ACK when this message arrives
+    bool                    adaptive_ack_rate;  // granted at init for a write
+    cr_FileCompression      compression;        // granted at init for a read
+    bool                    window_lossy;       // a loss was seen this window
+    uint32_t                ack_rate_threshold; // growth slows above this
+    uint32_t                ack_rate_max;
+    bool                    watchdog_active;
+    uint32_t                watchdog_period;    // ms
+    uint32_t                watchdog_target;    // ticks
+    uint32_t                start_offset;       // request_offset at init
+    uint32_t                page_crc32;         // crc32 where the write page starts
+    const uint8_t          *mapped_data;        // a read's data at start_offset
 } cr_FileTransferStateMachine;
 
-cr_FileTransferStateMachine sCr_file_xfer_state;
+// Transfers are keyed by the transfer_id given at init.
+static cr_FileTransferStateMachine sCr_file_xfer_table[NUM_FILE_TRANSFERS];
+
+// The transfer being serviced.  Each entry point selects it.
+static cr_FileTransferStateMachine *sCr_file_xfer = &sCr_file_xfer_table[0];
+
+// A transfer is open from init until it completes or fails.
+static bool transfer_is_open(const cr_FileTransferStateMachine *xfer)
+{
+    return (xfer->state == cr_FileTransferState_INIT) ||
+           (xfer->state == cr_FileTransferState_DATA);
+}
+
+// Returns the transfer with this transfer_id, or NULL.
+static cr_FileTransferStateMachine *transfer_find(uint32_t transfer_id)
+{
+    for (int i = 0; i < NUM_FILE_TRANSFERS; i++)
+    {
+        cr_FileTransferStateMachine *xfer = &sCr_file_xfer_table[i];
+        if ((xfer->transfer_id == transfer_id) &&
+            (xfer->state != cr_FileTransferState_IDLE) &&
+            (xfer->state != cr_FileTransferState_FILE_TRANSFER_INVALID))
+            return xfer;
+    }
+    return NULL;
+}
+
+// Returns the entry for a new transfer, or NULL if all are busy.  
+// A client that repeats an init restarts its transfer.  Otherwise a free 
+// entry is used, then a finished one, then an open one whose watchdog has 
+// stopped.  A transfer with no timeout can therefore be displaced when the 
+// table is full.
+static cr_FileTransferStateMachine *transfer_alloc(uint32_t transfer_id)
+{
+    cr_FileTransferStateMachine *xfer = transfer_find(transfer_id);
+    if (xfer != NULL)
+        return xfer;
+
+    int best_rank = 3;
+    for (int i = 0; i < NUM_FILE_TRANSFERS; i++)
+    {
+        cr_FileTransferStateMachine *x = &sCr_file_xfer_table[i];
+        int rank;
+        if (x->state == cr_FileTransferState_COMPLETE)
+            rank = 1;
+        else if (!transfer_is_open(x))
+            rank = 0;
+        else if (!x->watchdog_active)
+            rank = 2;
+        else
+            continue;
+        if (rank < best_rank)
+        {
+            best_rank = rank;
+            xfer = x;
+        }
+    }
+    return xfer;
+}
+
+// A read sends the rest of its window as a continued transaction.  
+// Returns the next read with packets to send after the current one, so that
+// reads take turns, or NULL if there are none.
+static cr_FileTransferStateMachine *next_read(void)
+{
+    int current = sCr_file_xfer - sCr_file_xfer_table;
+    for (int n = 1; n <= NUM_FILE_TRANSFERS; n++)
+    {
+        cr_FileTransferStateMachine *xfer = 
+            &sCr_file_xfer_table[(current + n) % NUM_FILE_TRANSFERS];
+        if (!xfer->read_write && 
+            (xfer->state == cr_FileTransferState_DATA) &&
+            (xfer->messages_until_ack != 0))
+            return xfer;
+    }
+    return NULL;
+}
+
+bool pvtCrFile_read_pending(void)
+{
+    return next_read() != NULL;
+}
+
+// After a new connection each read waits for the client to ACK again.
+void pvtCrFile_hold_reads(void)
+{
+    for (int i = 0; i < NUM_FILE_TRANSFERS; i++)
+    {
+        if (!sCr_file_xfer_table[i].read_write)
+            sCr_file_xfer_table[i].messages_until_ack = 0;
+    }
+}
+
+#if NUM_FILE_REORDER_SLOTS != 0
+  // The received map has one bit per message in a window.
+  #define CR_SELECTIVE_ACK_MAX_WINDOW   32
+
+  // A message that arrived ahead of a gap, waiting to be written.
+  typedef struct _cr_FileReorderSlot {
+      uint32_t                                    message_number; // 0 if free
+      cr_FileTransferStateMachine                 *owner;
+      cr_FileTransferStateMachine_message_data_t  data;
+  } cr_FileReorderSlot;
+
+  static cr_FileReorderSlot sCr_file_reorder[NUM_FILE_REORDER_SLOTS];
+
+// Frees the slots held for a transfer that ended or was replaced.
+static void reorder_release(const cr_FileTransferStateMachine *xfer)
+{
+    for (int i = 0; i < NUM_FILE_REORDER_SLOTS; i++)
+    {
+        if (sCr_file_reorder[i].owner == xfer)
+            sCr_file_reorder[i].message_number = 0;
+    }
+}
+#else
+static void reorder_release(const cr_FileTransferStateMachine *xfer) { (void)xfer; }
+#endif
+
+#ifdef INCLUDE_ADAPTIVE_ACK_RATE
+// Like a congestion window, messages_per_ack doubles after each window that 
+// arrives whole, until the first loss.  After that it grows by one.  
+// A loss halves it, once per window.  The new rate applies from the next 
+// ACK, which reports it to the client.
+// Reads keep a fixed rate.  Their packets give number_of_objects and 
+// remaining_objects, so a reader could follow a new window, but the ACK of
+// a read does not tell the server what was lost.
+static void ack_rate_window_end(void)
+{
+    if (!sCr_file_xfer->adaptive_ack_rate)
+        return;
+    if (sCr_file_xfer->window_lossy)
+    {
+        sCr_file_xfer->window_lossy = false;
+        return;
+    }
+    uint32_t rate = sCr_file_xfer->messages_per_ack;
+    if (rate < sCr_file_xfer->ack_rate_threshold)
+        rate *= 2;
+    else
+        rate++;
+    if (rate > sCr_file_xfer->ack_rate_max)
+        rate = sCr_file_xfer->ack_rate_max;
+    sCr_file_xfer->messages_per_ack = rate;
+}
+
+static void ack_rate_loss(void)
+{
+    if (!sCr_file_xfer->adaptive_ack_rate || sCr_file_xfer->window_lossy)
+        return;
+    sCr_file_xfer->window_lossy = true;
+    uint32_t rate = sCr_file_xfer->messages_per_ack / 2;
+    if (rate < ADAPTIVE_ACK_RATE_MIN)
+        rate = ADAPTIVE_ACK_RATE_MIN;
+    sCr_file_xfer->messages_per_ack   = rate;
+    sCr_file_xfer->ack_rate_threshold = rate;
+    I3_LOG(LOG_MASK_FILES, "Loss, ack rate now %d.", rate);
+}
+#else
+  #define ack_rate_window_end()
+  #define ack_rate_loss()
+#endif  // def INCLUDE_ADAPTIVE_ACK_RATE
+
+// Tells the client how many messages to send before the next ACK.
+static void ack_rate_report(cr_FileTransferDataNotification *response)
+{
+    if (sCr_file_xfer->adaptive_ack_rate)
+        response->messages_per_ack = sCr_file_xfer->messages_per_ack;
+}
+
+#ifdef FILE_WRITE_PAGE_SIZE
+// Written data is gathered here and given to crcb_write_file() a page at a 
+// time, aligned to the page.  The app may program one buffer while the 
+// other fills.
+// The buffers serve one write until it ends.  A write that runs alongside 
+// it is given to the app unbuffered.
+static uint8_t  sCr_write_page[2][FILE_WRITE_PAGE_SIZE];
+static int      sCr_write_page_index;   // the buffer filling
+static uint32_t sCr_write_page_offset;  // file offset of its first byte
+static uint32_t sCr_write_page_fill;    // bytes in it
+static cr_FileTransferStateMachine *sCr_write_page_owner;
+
+// Drops any data buffered for the current transfer.
+static void write_page_reset(void)
+{
+    if (sCr_write_page_owner != sCr_file_xfer)
+        return;
+    sCr_write_page_owner  = NULL;
+    sCr_write_page_offset = 0;
+    sCr_write_page_fill   = 0;
+}
+
+// Gives the buffered data to the app and switches buffers.
+static int write_page_flush(void)
+{
+    if (sCr_write_page_fill == 0)
+        return 0;
+    int rval = crcb_write_file(sCr_write_page_owner->file_id,
+                               sCr_write_page_offset,
+                               sCr_write_page_fill,
+                               sCr_write_page[sCr_write_page_index]);
+    sCr_write_page_index ^= 1;
+    sCr_write_page_offset += sCr_write_page_fill;
+    sCr_write_page_fill = 0;
+    return rval;
+}
+
+// Adds data to the page buffer, writing each page as it fills.  
+// Data that does not follow what is buffered starts a new page.
+static int file_write(uint32_t offset, const uint8_t *data, size_t size)
+{
+    int rval;
+    const uint8_t *start = data;
+    if ((sCr_write_page_owner != NULL) && (sCr_write_page_owner != sCr_file_xfer))
+    {
+        if (transfer_is_open(sCr_write_page_owner))
+            return crcb_write_file(sCr_file_xfer->file_id, offset, size, data);
+        // A write that failed leaves data its checkpoint does not count.
+        sCr_write_page_fill = 0;
+    }
+    if ((sCr_write_page_fill != 0) && 
+        (offset != sCr_write_page_offset + sCr_write_page_fill))
+    {
+        rval = write_page_flush();
+        if (rval != 0)
+            return rval;
+    }
+    if (sCr_write_page_fill == 0)
+    {
+        sCr_write_page_owner  = sCr_file_xfer;
+        sCr_write_page_offset = offset;
+        sCr_file_xfer->page_crc32 = sCr_file_xfer->crc32;
+    }
+
+    while (size > 0)
+    {
+        // The first page of a transfer may start part way into the page.
+        size_t room = FILE_WRITE_PAGE_SIZE - 
+                      ((sCr_write_page_offset + sCr_write_page_fill) % FILE_WRITE_PAGE_SIZE);
+        size_t num = (size < room) ? size : room;
+        memcpy(&sCr_write_page[sCr_write_page_index][sCr_write_page_fill], data, num);
+        sCr_write_page_fill += num;
+        data += num;
+        size -= num;
+        if (num == room)
+        {
+            rval = write_page_flush();
+            if (rval != 0)
+                return rval;
+            // The transfer CRC is not yet updated for this data.
+            sCr_file_xfer->page_crc32 = pvtCr_crc32(sCr_file_xfer->crc32, 
+                                                    start, data - start);
+        }
+    }
+    return 0;
+}
+
+// Writes what is buffered at the end of the current transfer.
+static int write_page_finish(void)
+{
+    if (sCr_write_page_owner != sCr_file_xfer)
+        return 0;
+    int rval = write_page_flush();
+    sCr_write_page_owner = NULL;
+    return rval;
+}
+#else
+static void write_page_reset(void) {}
+static int  write_page_finish(void) { return 0; }
+static int  file_write(uint32_t offset, const uint8_t *data, size_t size)
+{
+    return crcb_write_file(sCr_file_xfer->file_id, offset, size, data);
+}
+#endif  // def FILE_WRITE_PAGE_SIZE
+
+#if FILE_READ_AHEAD_PACKETS != 0
+// During a file read the next packets are read from the file while the stack
+// is idle, usually while waiting for an ACK.  Sending a packet then only 
+// copies its data.
+typedef struct _cr_FileReadAheadSlot {
+    uint32_t                                    offset; // in the file
+    cr_FileTransferStateMachine_message_data_t  data;
+} cr_FileReadAheadSlot;
+
+// The buffer serves one read at a time, until it ends.
+static cr_FileReadAheadSlot sCr_read_ahead[FILE_READ_AHEAD_PACKETS];
+static int      sCr_read_ahead_head;    // the next slot to send
+static int      sCr_read_ahead_count;   // slots filled
+static uint32_t sCr_read_ahead_next;    // file offset of the next to fill
+static cr_FileTransferStateMachine *sCr_read_ahead_owner;
+
+// Drops any packets read ahead for the current transfer.
+static void read_ahead_reset(void)
+{
+    if (sCr_read_ahead_owner != sCr_file_xfer)
+        return;
+    sCr_read_ahead_head  = 0;
+    sCr_read_ahead_count = 0;
+}
+
+// Copies the packet at offset if it was read ahead.  
+// Returns the number of bytes, or -1 if the file must be read.
+static int read_ahead_take(uint32_t offset, uint8_t *pData)
+{
+    if ((sCr_read_ahead_count == 0) || (sCr_read_ahead_owner != sCr_file_xfer))
+        return -1;
+    cr_FileReadAheadSlot *slot = &sCr_read_ahead[sCr_read_ahead_head];
+    if (slot->offset != offset)
+    {
+        read_ahead_reset();
+        return -1;
+    }
+    memcpy(pData, slot->data.bytes, slot->data.size);
+    sCr_read_ahead_head = (sCr_read_ahead_head + 1) % FILE_READ_AHEAD_PACKETS;
+    sCr_read_ahead_count--;
+    return slot->data.size;
+}
+#else
+static void read_ahead_reset(void) {}
+static int  read_ahead_take(uint32_t offset, uint8_t *pData) { return -1; }
+#endif  // FILE_READ_AHEAD_PACKETS != 0
+
+// Called when the stack is idle.  Reads one more packet ahead.
+void pvtCrFile_read_ahead(void)
+{
+  #if FILE_READ_AHEAD_PACKETS != 0
+    cr_FileTransferStateMachine *xfer = sCr_read_ahead_owner;
+    if ((xfer == NULL) || xfer->read_write || !transfer_is_open(xfer) ||
+        (xfer->mapped_data != NULL))
+    {
+        // Serve the first open read.
+        sCr_read_ahead_head  = 0;
+        sCr_read_ahead_count = 0;
+        sCr_read_ahead_owner = NULL;
+        for (int i = 0; i < NUM_FILE_TRANSFERS; i++)
+        {
+            xfer = &sCr_file_xfer_table[i];
+            // A mapped file has nothing to gain.
+            if (!xfer->read_write && transfer_is_open(xfer) &&
+                (xfer->mapped_data == NULL))
+            {
+                sCr_read_ahead_owner = xfer;
+                break;
+            }
+        }
+        if (sCr_read_ahead_owner == NULL)
+            return;
+    }
+    if (sCr_read_ahead_count == FILE_READ_AHEAD_PACKETS)
+        return;
+    if (sCr_read_ahead_count == 0)
+        sCr_read_ahead_next = xfer->request_offset;
+
+    uint32_t end = xfer->request_offset + 
+                   xfer->transfer_length - 
+                   xfer->bytes_transfered;
+    if (sCr_read_ahead_next >= end)
+        return;
+    size_t bytes_requested = end - sCr_read_ahead_next;
+    if (bytes_requested > REACH_BYTES_IN_A_FILE_PACKET)
+        bytes_requested = REACH_BYTES_IN_A_FILE_PACKET;
+
+    int tail = (sCr_read_ahead_head + sCr_read_ahead_count) % FILE_READ_AHEAD_PACKETS;
+    cr_FileReadAheadSlot *slot = &sCr_read_ahead[tail];
+    int bytes_read = 0;
+    int rval = crcb_read_file(xfer->file_id,
+                              sCr_read_ahead_next,
+                              bytes_requested,
+                              slot->data.bytes,
+                              &bytes_read);
+    if ((rval != 0) || (bytes_read <= 0))
+    {
+        // Stop here.  Sending will read the file and report the error.
+        sCr_read_ahead_next = end;
+        return;
+    }
+    slot->offset = sCr_read_ahead_next;
+    slot->data.size = bytes_read;
+    sCr_read_ahead_next += bytes_read;
+    sCr_read_ahead_count++;
+  #endif  // FILE_READ_AHEAD_PACKETS != 0
+}
+
+// Reads the next data of a file read, from the read ahead buffer if it is 
+// there, and adds it to the transfer CRC.
+static int read_file_data(uint8_t *pData, size_t bytes_requested, int *bytes_read)
+{
+    int rval = 0;
+    *bytes_read = read_ahead_take(sCr_file_xfer->request_offset, pData);
+    if ((*bytes_read < 0) && (sCr_file_xfer->mapped_data != NULL))
+    {
+        // A compressed read of a mapped file.
+        memcpy(pData, sCr_file_xfer->mapped_data + 
+               (sCr_file_xfer->request_offset - sCr_file_xfer->start_offset),
+               bytes_requested);
+        *bytes_read = bytes_requested;
+    }
+    else if (*bytes_read < 0)
+    {
+        *bytes_read = 0;
+        rval = crcb_read_file(sCr_file_xfer->file_id,
+                              sCr_file_xfer->request_offset,
+                              bytes_requested,
+                              pData,
+                              bytes_read);
+        if (rval != 0)
+            return rval;
+    }
+    sCr_file_xfer->bytes_transfered += *bytes_read;
+    sCr_file_xfer->request_offset += *bytes_read;
+    sCr_file_xfer->crc32 = pvtCr_crc32(sCr_file_xfer->crc32,
+                                       pData, *bytes_read);
+    return 0;
+}
+
+#ifdef INCLUDE_FILE_MAPPED_READS
+// The next packet of a mapped file read.  It is not copied here, but 
+// encoded straight from the file by cr_encode_message().
+static const uint8_t *sCr_file_mapped_packet;
+static size_t         sCr_file_mapped_size;
+
+bool pvtCrFile_take_mapped_data(const uint8_t **ppData, size_t *size)
+{
+    if (sCr_file_mapped_packet == NULL)
+        return false;
+    *ppData = sCr_file_mapped_packet;
+    *size   = sCr_file_mapped_size;
+    sCr_file_mapped_packet = NULL;
+    return true;
+}
+
+// Like read_file_data(), but gives a pointer to the data.
+static int read_mapped_data(const uint8_t **ppData, size_t bytes_requested, 
+                            int *bytes_read)
+{
+    *ppData = sCr_file_xfer->mapped_data + 
+              (sCr_file_xfer->request_offset - sCr_file_xfer->start_offset);
+    *bytes_read = bytes_requested;
+    sCr_file_xfer->bytes_transfered += bytes_requested;
+    sCr_file_xfer->request_offset += bytes_requested;
+    sCr_file_xfer->crc32 = pvtCr_crc32(sCr_file_xfer->crc32,
+                                       *ppData, bytes_requested);
+    sCr_file_mapped_packet = *ppData;
+    sCr_file_mapped_size   = bytes_requested;
+    return 0;
+}
+#endif  // def INCLUDE_FILE_MAPPED_READS
+
+#ifdef INCLUDE_FILE_COMPRESSION
+// File data waiting to be compressed.
+static uint8_t  sCr_lzss_input[REACH_BYTES_IN_A_FILE_PACKET];
+static size_t   sCr_lzss_input_size;
+static size_t   sCr_lzss_input_used;
+static int      sCr_lzss_read_error;
+
+// Gives file data to the compressor, reading a packet's worth at a time.
+static size_t lzss_read(uint8_t *buf, size_t max)
+{
+    if (sCr_lzss_input_used == sCr_lzss_input_size)
+    {
+        sCr_lzss_input_size = 0;
+        sCr_lzss_input_used = 0;
+        size_t bytes_requested = sCr_file_xfer->transfer_length - 
+                                 sCr_file_xfer->bytes_transfered;
+        if ((bytes_requested == 0) || (sCr_lzss_read_error != 0))
+            return 0;
+        if (bytes_requested > REACH_BYTES_IN_A_FILE_PACKET)
+            bytes_requested = REACH_BYTES_IN_A_FILE_PACKET;
+        int bytes_read = 0;
+        sCr_lzss_read_error = read_file_data(sCr_lzss_input, bytes_requested, &bytes_read);
+        if ((sCr_lzss_read_error != 0) || (bytes_read <= 0))
+            return 0;
+        sCr_lzss_input_size = bytes_read;
+    }
+    size_t num = sCr_lzss_input_size - sCr_lzss_input_used;
+    if (num > max)
+        num = max;
+    memcpy(buf, &sCr_lzss_input[sCr_lzss_input_used], num);
+    sCr_lzss_input_used += num;
+    return num;
+}
+
+static void lzss_read_start(void)
+{
+    sCr_lzss_input_size = 0;
+    sCr_lzss_input_used = 0;
+    sCr_lzss_read_error = 0;
+    pvtCr_lzss_start(lzss_read);
+}
+#endif  // def INCLUDE_FILE_COMPRESSION
+
+#ifdef INCLUDE_FILE_RESUME
+// A checkpoint records how much of a write has been given to the app.  
+// Data still in the page buffer is not counted, so a resumed write 
+// starts where the app's data ends.  The app may keep the checkpoint 
+// in NVM to resume after a reset.  This copy is enough across a 
+// disconnect.
+static cr_FileTransferCheckpoint sCr_file_checkpoint;
+
+static void checkpoint_save(void)
+{
+    cr_FileTransferCheckpoint cp;
+    cp.file_id          = sCr_file_xfer->file_id;
+    cp.transfer_id      = sCr_file_xfer->transfer_id;
+    cp.start_offset     = sCr_file_xfer->start_offset;
+    cp.transfer_length  = sCr_file_xfer->transfer_length;
+    cp.committed_offset = sCr_file_xfer->request_offset;
+    cp.crc32            = sCr_file_xfer->crc32;
+  #ifdef FILE_WRITE_PAGE_SIZE
+    if ((sCr_write_page_owner == sCr_file_xfer) && (sCr_write_page_fill != 0) &&
+        (sCr_write_page_offset < cp.committed_offset))
+    {
+        cp.committed_offset = sCr_write_page_offset;
+        cp.crc32            = sCr_file_xfer->page_crc32;
+    }
+  #endif
+    if (memcmp(&cp, &sCr_file_checkpoint, sizeof(cp)) == 0)
+        return;
+    sCr_file_checkpoint = cp;
+    crcb_file_save_checkpoint(&cp);
+}
+
+// A zero transfer_length marks that there is nothing to resume.
+static void checkpoint_clear(uint32_t fid)
+{
+    cr_FileTransferCheckpoint cp;
+    memset(&cp, 0, sizeof(cp));
+    cp.file_id = fid;
+    if (sCr_file_checkpoint.file_id == fid)
+        sCr_file_checkpoint = cp;
+    crcb_file_save_checkpoint(&cp);
+}
+
+// Returns true if the checkpoint continues the write described by request.
+static bool checkpoint_load(const cr_FileTransferInit *request,
+                            cr_FileTransferCheckpoint *cp)
+{
+    if ((sCr_file_checkpoint.file_id == request->file_id) &&
+        (sCr_file_checkpoint.transfer_length != 0))
+        *cp = sCr_file_checkpoint;
+    else if (crcb_file_load_checkpoint(request->file_id, cp) != 0)
+        return false;
+
+    if ((cp->file_id != request->file_id) ||
+        (cp->transfer_id != request->transfer_id) ||
+        (cp->start_offset != request->request_offset) ||
+        (cp->transfer_length == 0) ||
+        (cp->transfer_length != request->transfer_length) ||
+        (cp->committed_offset < cp->start_offset) ||
+        (cp->committed_offset >= cp->start_offset + cp->transfer_length))
+    {
+        I3_LOG(LOG_MASK_WARN, "No checkpoint to resume fid %d.", request->file_id);
+        return false;
+    }
+    return true;
+}
+#else
+static void checkpoint_save(void) {}
+static void checkpoint_clear(uint32_t fid) { (void)fid; }
+#endif  // def INCLUDE_FILE_RESUME
+
+// The write is complete.  The app is told unless the CRC of the whole
+// transfer does not match what the client gave at init.
+static int finish_write(cr_FileTransferDataNotification *response)
+{
+    reorder_release(sCr_file_xfer);
+    // All the data reaches the app before the final ACK.
+    int rval = write_page_finish();
+    if (rval != 0)
+    {
+        LOG_ERROR("Final file write to fid %d failed with error %d", 
+                  sCr_file_xfer->file_id, rval);
+        sCr_file_xfer->state = cr_FileTransferState_IDLE;
+        response->result = cr_ErrorCodes_WRITE_FAILED;
+        cr_report_error(cr_ErrorCodes_WRITE_FAILED, 
+                        "%s: Final write for fid %d failed.",
+                        __FUNCTION__, sCr_file_xfer->file_id);
+        pvtCr_watchdog_end_timeout();
+        return cr_ErrorCodes_WRITE_FAILED;
+    }
+    sCr_file_xfer->state = cr_FileTransferState_COMPLETE;
+    checkpoint_clear(sCr_file_xfer->file_id);
+    I3_LOG(LOG_MASK_ALWAYS, "file write complete.");
+    if (sCr_file_xfer->bytes_transfered > sCr_file_xfer->transfer_length)
+    {
+        I3_LOG(LOG_MASK_WARN, "On file write, remaining bytes is below zero.");
+    }
+    response->is_complete = true;
+    pvtCr_watchdog_end_timeout();
+    if (sCr_file_xfer->has_expected_crc32 && 
+        (sCr_file_xfer->expected_crc32 != sCr_file_xfer->crc32))
+    {
+        // The app is not told the file is complete.
+        LOG_ERROR("File write CRC 0x%x, expected 0x%x.", 
+                  sCr_file_xfer->crc32, sCr_file_xfer->expected_crc32);
+        response->result = cr_ErrorCodes_CHECKSUM_MISMATCH;
+        sprintf(response->error_message, "File CRC 0x%x, expected 0x%x.", 
+                (unsigned)sCr_file_xfer->crc32, 
+                (unsigned)sCr_file_xfer->expected_crc32);
+        return 0;
+    }
+    crcb_file_transfer_complete(sCr_file_xfer->file_id);
+    return 0;
+}
+
+#if NUM_FILE_REORDER_SLOTS != 0
+// With selective acknowledgement the messages of each window are numbered 
+// from 1.  The window holds messages_per_ack messages, or fewer at the end.
+// Every message but the last of the transfer must be a full packet.
+static void window_start(void)
+{
+    uint32_t remaining = sCr_file_xfer->transfer_length - 
+                         sCr_file_xfer->bytes_transfered;
+    uint32_t packets = (remaining + REACH_BYTES_IN_A_FILE_PACKET - 1) / 
+                       REACH_BYTES_IN_A_FILE_PACKET;
+    if (packets > sCr_file_xfer->messages_per_ack)
+        packets = sCr_file_xfer->messages_per_ack;
+    sCr_file_xfer->window_length = packets;
+    sCr_file_xfer->received_map  = 0;
+    sCr_file_xfer->ack_trigger   = packets;
+    sCr_file_xfer->message_number = 0;  // the last written in order
+}
+
+// The size of message num of the window.  The window starts after the 
+// messages written in order, and every message is a full packet until the
+// end of the transfer.
+static uint32_t message_size(uint32_t num)
+{
+    uint32_t offset = sCr_file_xfer->bytes_transfered + 
+        (num - 1 - sCr_file_xfer->message_number) * REACH_BYTES_IN_A_FILE_PACKET;
+    if (offset >= sCr_file_xfer->transfer_length)
+        return 0;
+    uint32_t size = sCr_file_xfer->transfer_length - offset;
+    return (size > REACH_BYTES_IN_A_FILE_PACKET) ? REACH_BYTES_IN_A_FILE_PACKET : size;
+}
+
+// Writes the next message in order and adds it to the transfer CRC.
+static int write_in_order(const uint8_t *bytes, int size)
+{
+    int rval = file_write(sCr_file_xfer->request_offset, bytes, size);
+    if (rval != 0)
+        return rval;
+    sCr_file_xfer->request_offset   += size;
+    sCr_file_xfer->bytes_transfered += size;
+    sCr_file_xfer->crc32 = pvtCr_crc32(sCr_file_xfer->crc32, bytes, size);
+    sCr_file_xfer->message_number++;
+    return 0;
+}
+
+// Messages are written in order.  One that arrives ahead of a gap is held in 
+// a reorder slot until the gap is filled.  One that is damaged, or finds no 
+// free slot, is dropped and the received map asks for it again.
+// The ACK is sent when the last message of the window arrives.  After that,
+// it is sent when the highest missing message arrives.  A client that gets
+// no ACK resends that message.
+static int transfer_data_selective(const cr_FileTransferData *dataTransfer,
+                                   cr_FileTransferDataNotification *response)
+{
+    uint32_t num = dataTransfer->message_number;
+    int bytes_to_write = dataTransfer->message_data.size;
+    int rval = 0;
+
+    if ((num == 0) || (num > sCr_file_xfer->window_length))
+    {
+        I3_LOG(LOG_MASK_WARN, "Message %d is outside the window of %d.", 
+               num, sCr_file_xfer->window_length);
+    }
+    else if (dataTransfer->has_packet_crc32 &&
+             (dataTransfer->packet_crc32 != 
+                pvtCr_crc32(0, dataTransfer->message_data.bytes, bytes_to_write)))
+    {
+        LOG_ERROR("At %d, CRC mismatch in message %d.", 
+                  sCr_file_xfer->bytes_transfered, num);
+    }
+    else if ((uint32_t)bytes_to_write != message_size(num))
+    {
+        // Data past transfer_length, or a short packet that would shift 
+        // the messages after it.
+        LOG_ERROR("Message %d has %d bytes, not %d.", 
+                  num, bytes_to_write, message_size(num));
+        sCr_file_xfer->state = cr_FileTransferState_IDLE;
+        reorder_release(sCr_file_xfer);
+        response->result = cr_ErrorCodes_INVALID_PARAMETER;
+        cr_report_error(cr_ErrorCodes_INVALID_PARAMETER, 
+                        "%s: Message %d has %d bytes, not %d.",
+                        __FUNCTION__, num, bytes_to_write, message_size(num));
+        pvtCr_watchdog_end_timeout();
+        return cr_ErrorCodes_INVALID_PARAMETER;
+    }
+    else if (sCr_file_xfer->received_map & (1u << (num - 1)))
+    {
+        I3_LOG(LOG_MASK_FILES, "Message %d is a duplicate.", num);
+    }
+    else if (num == sCr_file_xfer->message_number + 1)
+    {
+        rval = write_in_order(dataTransfer->message_data.bytes, bytes_to_write);
+        // Write any held messages that now follow in order.
+        for (int i = 0; (rval == 0) && (i < NUM_FILE_REORDER_SLOTS); i++)
+        {
+            if ((sCr_file_reorder[i].owner != sCr_file_xfer) ||
+                (sCr_file_reorder[i].message_number != 
+                    sCr_file_xfer->message_number + 1))
+                continue;
+            rval = write_in_order(sCr_file_reorder[i].data.bytes, 
+                                  sCr_file_reorder[i].data.size);
+            sCr_file_reorder[i].message_number = 0;
+            i = -1;  // search again for the next
+        }
+        if (rval != 0)
+        {
+            LOG_ERROR("File write to fid %d failed with error %d", 
+                      sCr_file_xfer->file_id, rval);
+            response->result = cr_ErrorCodes_WRITE_FAILED;
+            cr_report_error(cr_ErrorCodes_WRITE_FAILED, 
+                            "%s: Write at offset %d for fid %d failed.",
+                            __FUNCTION__, sCr_file_xfer->request_offset, 
+                            sCr_file_xfer->file_id);
+            reorder_release(sCr_file_xfer);
+            pvtCr_watchdog_end_timeout();
+            return cr_ErrorCodes_WRITE_FAILED;
+        }
+        sCr_file_xfer->received_map |= (1u << (num - 1));
+    }
+    else
+    {
+        // A slot still held by a transfer that has ended is free.
+        int i;
+        for (i = 0; i < NUM_FILE_REORDER_SLOTS; i++)
+        {
+            if ((sCr_file_reorder[i].message_number == 0) ||
+                !transfer_is_open(sCr_file_reorder[i].owner))
+                break;
+        }
+        if (i < NUM_FILE_REORDER_SLOTS)
+        {
+            sCr_file_reorder[i].message_number = num;
+            sCr_file_reorder[i].owner = sCr_file_xfer;
+            sCr_file_reorder[i].data.size = bytes_to_write;
+            memcpy(sCr_file_reorder[i].data.bytes, 
+                   dataTransfer->message_data.bytes, bytes_to_write);
+            sCr_file_xfer->received_map |= (1u << (num - 1));
+        }
+        else
+        {
+            I3_LOG(LOG_MASK_WARN, "No reorder slot for message %d.", num);
+        }
+    }
+
+    pvtCr_watchdog_stroke_timeout(cr_get_current_ticks());
+
+    uint32_t window_map = (sCr_file_xfer->window_length >= 32) ? 0xFFFFFFFF :
+                          ((1u << sCr_file_xfer->window_length) - 1);
+    bool window_full = (sCr_file_xfer->received_map == window_map);
+    bool complete = (sCr_file_xfer->bytes_transfered >= 
+                     sCr_file_xfer->transfer_length);
+    if (!complete && !window_full && (num < sCr_file_xfer->ack_trigger))
+        return cr_ErrorCodes_NO_RESPONSE;
+
+    response->has_received_map = true;
+    response->received_map = sCr_file_xfer->received_map;
+    response->has_transfer_crc32 = true;
+    response->transfer_crc32 = sCr_file_xfer->crc32;
+    response->retry_offset = sCr_file_xfer->request_offset;
+
+    if (complete)
+        return finish_write(response);
+
+    if (window_full)
+    {
+        I3_LOG(LOG_MASK_FILES, "ACK file write window of %d.", 
+               sCr_file_xfer->window_length);
+        ack_rate_window_end();
+        window_start();
+        ack_rate_report(response);
+        checkpoint_save();
+        return 0;
+    }
+
+    // The client resends the missing messages in order.  
+    // The last of them triggers the next ACK.
+    for (uint32_t n = sCr_file_xfer->window_length; n > 0; n--)
+    {
+        if (!(sCr_file_xfer->received_map & (1u << (n - 1))))
+        {
+            sCr_file_xfer->ack_trigger = n;
+            break;
+        }
+    }
+    I3_LOG(LOG_MASK_FILES, "ACK file write, map 0x%x, resend to %d.", 
+           sCr_file_xfer->received_map, sCr_file_xfer->ack_trigger);
+    // The rate applies from the next window.
+    ack_rate_loss();
+    ack_rate_report(response);
+    checkpoint_save();
+    return 0;
+}
+#endif  // NUM_FILE_REORDER_SLOTS != 0
 
 int pvtCrFile_transfer_init(const cr_FileTransferInit *request,
                                cr_FileTransferInitResponse *response)
 {
     if (!pvtCr_challenge_key_is_valid()) {
-        sCr_file_xfer_state.state = cr_FileTransferState_IDLE; 
         response->result = cr_ErrorCodes_CHALLENGE_FAILED;
         pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
         return cr_ErrorCodes_NO_DATA; 
@@ -162,12 +974,29 @@ int pvtCrFile_transfer_init(const cr_FileTransferInit *request,
     cr_FileInfo file_desc;
     memset(response, 0, sizeof(cr_FileTransferInitResponse));
     response->transfer_id = request->transfer_id;
-    memset(&sCr_file_xfer_state, 0, sizeof(cr_FileTransferStateMachine));
-    sCr_file_xfer_state.state = cr_FileTransferState_IDLE;
+
+    cr_FileTransferStateMachine *xfer = transfer_alloc(request->transfer_id);
+    if (xfer == NULL)
+    {
+        cr_report_error(cr_ErrorCodes_NO_RESOURCE, 
+                        "%s No free transfer for transfer_id %d.", 
+                        __FUNCTION__, request->transfer_id);
+        // The error report used the response buffer.
+        memset(response, 0, sizeof(cr_FileTransferInitResponse));
+        response->transfer_id = request->transfer_id;
+        response->result = cr_ErrorCodes_NO_RESOURCE;
+        return 0;
+    }
+    sCr_file_xfer = xfer;
+    write_page_reset();
+    read_ahead_reset();
+    reorder_release(sCr_file_xfer);
+    memset(sCr_file_xfer, 0, sizeof(cr_FileTransferStateMachine));
+    sCr_file_xfer->state = cr_FileTransferState_IDLE;
     int rval = crcb_file_get_description(request->file_id, &file_desc);
     if (rval != 0)
     {
-        sCr_file_xfer_state.state = cr_FileTransferState_IDLE; 
+        sCr_file_xfer->state = cr_FileTransferState_IDLE; 
         cr_report_error(cr_ErrorCodes_BAD_FILE, 
                         "%s No file description for fid %d.", 
                         __FUNCTION__, request->file_id);
@@ -178,7 +1007,7 @@ int pvtCrFile_transfer_init(const cr_FileTransferInit *request,
     {
     default:
     case cr_AccessLevel_NO_ACCESS:
-        sCr_file_xfer_state.state = cr_FileTransferState_IDLE;
+        sCr_file_xfer->state = cr_FileTransferState_IDLE;
         cr_report_error(cr_ErrorCodes_PERMISSION_DENIED, 
                         "%s File ID %d access permission denied.", 
                         __FUNCTION__, request->file_id);
@@ -187,7 +1016,7 @@ int pvtCrFile_transfer_init(const cr_FileTransferInit *request,
     case cr_AccessLevel_READ:
         if (request->read_write)    // 1 for write
         {
-            sCr_file_xfer_state.state = cr_FileTransferState_IDLE;
+            sCr_file_xfer->state = cr_FileTransferState_IDLE;
             cr_report_error(cr_ErrorCodes_PERMISSION_DENIED, 
                             "%s File ID %d write permission denied.", 
                             __FUNCTION__, request->file_id);
@@ -198,7 +1027,7 @@ int pvtCrFile_transfer_init(const cr_FileTransferInit *request,
     case cr_AccessLevel_WRITE:
         if (!request->read_write)   // 0 for read
         {
-            sCr_file_xfer_state.state = cr_FileTransferState_IDLE;
+            sCr_file_xfer->state = cr_FileTransferState_IDLE;
             cr_report_error(cr_ErrorCodes_PERMISSION_DENIED, 
                             "%s File ID %d read permission denied.", 
                             __FUNCTION__, request->file_id);
@@ -218,24 +1047,127 @@ int pvtCrFile_transfer_init(const cr_FileTransferInit *request,
     if (preferred_ack_rate == 0)
         preferred_ack_rate = 10;  // default
 
+    bool selective_ack = false;
+#if NUM_FILE_REORDER_SLOTS != 0
+    if (request->read_write && request->selective_ack)
+    {
+        selective_ack = true;
+        if (preferred_ack_rate > CR_SELECTIVE_ACK_MAX_WINDOW)
+            preferred_ack_rate = CR_SELECTIVE_ACK_MAX_WINDOW;
+    }
+#endif
+
+    // The adaptive rate starts from the rate chosen above.
+    bool adaptive_ack_rate = false;
+#ifdef INCLUDE_ADAPTIVE_ACK_RATE
+    uint32_t ack_rate_max = ADAPTIVE_ACK_RATE_MAX;
+    if (request->read_write && request->adaptive_ack_rate)
+    {
+        adaptive_ack_rate = true;
+  #if NUM_FILE_REORDER_SLOTS != 0
+        if (selective_ack && (ack_rate_max > CR_SELECTIVE_ACK_MAX_WINDOW))
+            ack_rate_max = CR_SELECTIVE_ACK_MAX_WINDOW;
+  #endif
+        if (preferred_ack_rate > (int)ack_rate_max)
+            preferred_ack_rate = ack_rate_max;
+        if (preferred_ack_rate < ADAPTIVE_ACK_RATE_MIN)
+            preferred_ack_rate = ADAPTIVE_ACK_RATE_MIN;
+    }
+#endif
+
+    cr_FileCompression compression = cr_FileCompression_NO_COMPRESSION;
+#ifdef INCLUDE_FILE_COMPRESSION
+    // There is one compressor, so one compressed read at a time.  
+    // A second is refused rather than sent plain to a client expecting LZSS.
+    if (!request->read_write && (request->compression == cr_FileCompression_LZSS))
+    {
+        compression = cr_FileCompression_LZSS;
+        for (int i = 0; i < NUM_FILE_TRANSFERS; i++)
+        {
+            if ((sCr_file_xfer_table[i].compression == cr_FileCompression_LZSS) &&
+                transfer_is_open(&sCr_file_xfer_table[i]))
+            {
+                cr_report_error(cr_ErrorCodes_NO_RESOURCE, 
+                                "%s Compressor busy for transfer_id %d.", 
+                                __FUNCTION__, request->transfer_id);
+                // The error report used the response buffer.
+                memset(response, 0, sizeof(cr_FileTransferInitResponse));
+                response->transfer_id = request->transfer_id;
+                response->result = cr_ErrorCodes_NO_RESOURCE;
+                return 0;
+            }
+        }
+    }
+#endif
+
     response->result = 0;
+    response->preferred_ack_rate = preferred_ack_rate;
+    response->compression = compression;
+    response->selective_ack = selective_ack;
+    response->adaptive_ack_rate = adaptive_ack_rate;
+
+    // sCr_file_xfer was zero'ed above.
+    sCr_file_xfer->state                   = cr_FileTransferState_INIT;
+    sCr_file_xfer->transfer_id             = request->transfer_id;
+    sCr_file_xfer->file_id                 = request->file_id;
+    sCr_file_xfer->timeout_in_ms           = request->timeout_in_ms;  
+    sCr_file_xfer->request_offset          = request->request_offset; 
+    sCr_file_xfer->transfer_length         = request->transfer_length;
+    sCr_file_xfer->read_write              = request->read_write;
+    sCr_file_xfer->message_number          = 0; 
+    sCr_file_xfer->crc32                   = 0;
+    sCr_file_xfer->has_expected_crc32      = request->has_transfer_crc32;
+    sCr_file_xfer->expected_crc32          = request->transfer_crc32;
+    sCr_file_xfer->messages_per_ack        = preferred_ack_rate;
+    sCr_file_xfer->messages_until_ack      = preferred_ack_rate;
+    sCr_file_xfer->bytes_transfered        = 0;
+    sCr_file_xfer->selective_ack           = selective_ack;
+    sCr_file_xfer->adaptive_ack_rate       = adaptive_ack_rate;
+    sCr_file_xfer->compression             = compression;
+    sCr_file_xfer->start_offset            = request->request_offset;
+#ifdef INCLUDE_FILE_MAPPED_READS
+    if (!request->read_write && (request->transfer_length != 0) &&
+        (crcb_file_get_mapped_data(request->file_id, request->request_offset,
+                                   request->transfer_length, 
+                                   &sCr_file_xfer->mapped_data) != 0))
+        sCr_file_xfer->mapped_data = NULL;
+#endif
+#ifdef INCLUDE_FILE_RESUME
+    cr_FileTransferCheckpoint checkpoint;
+    if (request->read_write && request->resume && 
+        checkpoint_load(request, &checkpoint))
+    {
+        sCr_file_xfer->request_offset   = checkpoint.committed_offset;
+        sCr_file_xfer->bytes_transfered = checkpoint.committed_offset - 
+                                          checkpoint.start_offset;
+        sCr_file_xfer->crc32            = checkpoint.crc32;
+        response->resume                = true;
+        response->resume_offset         = checkpoint.committed_offset;
+        response->has_transfer_crc32    = true;
+        response->transfer_crc32        = checkpoint.crc32;
+    }
+#endif
+#ifdef INCLUDE_FILE_COMPRESSION
+    if (compression == cr_FileCompression_LZSS)
+        lzss_read_start();
+#endif
+#ifdef INCLUDE_ADAPTIVE_ACK_RATE
+    sCr_file_xfer->ack_rate_threshold      = ack_rate_max;
+    sCr_file_xfer->ack_rate_max            = ack_rate_max;
+#endif
+#if NUM_FILE_REORDER_SLOTS != 0
+    if (selective_ack)
+        window_start();
+#endif
 
-    // sCr_file_xfer_state was zero'ed above.
-    sCr_file_xfer_state.state                   = cr_FileTransferState_INIT;
-    sCr_file_xfer_state.transfer_id             = request->transfer_id;
-    sCr_file_xfer_state.file_id                 = request->file_id;
-    sCr_file_xfer_state.timeout_in_ms           = request->timeout_in_ms;  
-    sCr_file_xfer_state.request_offset          = request->request_offset; 
-    sCr_file_xfer_state.transfer_length         = request->transfer_length;
-    sCr_file_xfer_state.read_write              = request->read_write;
-    sCr_file_xfer_state.message_number          = 0; 
-    sCr_file_xfer_state.crc32                   = 0;
-    sCr_file_xfer_state.messages_per_ack        = preferred_ack_rate;
-    sCr_file_xfer_state.messages_until_ack      = preferred_ack_rate;
-    sCr_file_xfer_state.bytes_transfered        = 0;
-
-    if (request->read_write)
+    if (request->read_write && response->resume)
+    {
+        I3_LOG(LOG_MASK_ALWAYS, "Resume file write at offset %d, timeout %d ms:", 
+               response->resume_offset, sCr_file_xfer->timeout_in_ms);
+    }
+    else if (request->read_write)
     {
+        checkpoint_clear(request->file_id);
         // give the app a chance to erase flash:
         int rval = 
         crcb_file_prepare_to_write(request->file_id, 
@@ -243,7 +1175,7 @@ int pvtCrFile_transfer_init(const cr_FileTransferInit *request,
                                    request->transfer_length);
         if (rval == 0) {
             I3_LOG(LOG_MASK_ALWAYS, "Start file write, timeout %d ms:", 
-                   sCr_file_xfer_state.timeout_in_ms);
+                   sCr_file_xfer->timeout_in_ms);
         }
         else
         {
@@ -255,14 +1187,16 @@ int pvtCrFile_transfer_init(const cr_FileTransferInit *request,
     else
     {
         I3_LOG(LOG_MASK_ALWAYS, "Start file read, timeout %d ms:", 
-                   sCr_file_xfer_state.timeout_in_ms);
+                   sCr_file_xfer->timeout_in_ms);
     }
 
-    I3_LOG(LOG_MASK_ALWAYS, "  File ID: %d. offset %d. size %d. msgs per ACK: %d",
+    I3_LOG(LOG_MASK_ALWAYS, "  File ID: %d. offset %d. size %d. msgs per ACK: %d%s",
            request->file_id, request->request_offset, request->transfer_length,
-           request->messages_per_ack);
+           request->messages_per_ack, selective_ack ? ", selective" : "");
+    if (adaptive_ack_rate)
+        I3_LOG(LOG_MASK_ALWAYS, "  Adaptive ack rate from %d.", preferred_ack_rate);
 
-    pvtCr_watchdog_start_timeout(sCr_file_xfer_state.timeout_in_ms, 
+    pvtCr_watchdog_start_timeout(sCr_file_xfer->timeout_in_ms, 
                                  cr_get_current_ticks());
 
     return 0;
@@ -275,8 +1209,10 @@ int pvtCrFile_transfer_init(const cr_FileTransferInit *request,
 int pvtCrFile_transfer_data(const cr_FileTransferData *dataTransfer,
                          cr_FileTransferDataNotification *response)
 {
+    cr_FileTransferStateMachine *xfer = transfer_find(dataTransfer->transfer_id);
     if (!pvtCr_challenge_key_is_valid()) {
-        sCr_file_xfer_state.state = cr_FileTransferState_IDLE; 
+        if (xfer != NULL)
+            xfer->state = cr_FileTransferState_IDLE; 
         response->result = cr_ErrorCodes_CHALLENGE_FAILED;
         pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
         return cr_ErrorCodes_NO_DATA; 
@@ -284,7 +1220,18 @@ int pvtCrFile_transfer_data(const cr_FileTransferData *dataTransfer,
 
     // we receive this on write.
     memset(response, 0, sizeof(cr_FileTransferDataNotification));
-    switch (sCr_file_xfer_state.state)
+    response->transfer_id = dataTransfer->transfer_id;
+    if (xfer == NULL)
+    {
+        LOG_ERROR("No transfer with transfer_id %d", dataTransfer->transfer_id);
+        cr_report_error(cr_ErrorCodes_INVALID_PARAMETER, 
+                        "%s: No transfer with transfer_id %d.", 
+                        __FUNCTION__, dataTransfer->transfer_id);
+        response->result = cr_ErrorCodes_INVALID_PARAMETER;
+        return cr_ErrorCodes_INVALID_PARAMETER;
+    }
+    sCr_file_xfer = xfer;
+    switch (sCr_file_xfer->state)
     {
     default:
     case cr_FileTransferState_FILE_TRANSFER_INVALID:
@@ -312,21 +1259,20 @@ int pvtCrFile_transfer_data(const cr_FileTransferData *dataTransfer,
     case cr_FileTransferState_DATA:
         break;
     }
-    if (dataTransfer->transfer_id != sCr_file_xfer_state.transfer_id)
+    if (!sCr_file_xfer->read_write)
     {
-        // the transfer_id is not rigorously enforced (yet)
-        I3_LOG(LOG_MASK_WARN, "Unmatched transfer_id (%d not %d)", 
-                  dataTransfer->transfer_id, sCr_file_xfer_state.transfer_id);
-        // response->result = cr_ErrorCodes_INVALID_PARAMETER;
-        // return 0;
+        LOG_ERROR("Expecting write, not read");
+        cr_report_error(cr_ErrorCodes_INVALID_STATE, 
+                        "%s Expecting write, not read.", __FUNCTION__);
+        response->result = cr_ErrorCodes_READ_FAILED;
+        return cr_ErrorCodes_READ_FAILED;
     }
-    response->transfer_id = dataTransfer->transfer_id;
     int bytes_to_write = dataTransfer->message_data.size;
     if (bytes_to_write > REACH_BYTES_IN_A_FILE_PACKET)
     {
         LOG_ERROR("Requested write of %d bytes > REACH_BYTES_IN_A_FILE_PACKET (%d).",
                   bytes_to_write, REACH_BYTES_IN_A_FILE_PACKET);
-        sCr_file_xfer_state.state = cr_FileTransferState_IDLE;
+        sCr_file_xfer->state = cr_FileTransferState_IDLE;
         response->result = cr_ErrorCodes_INVALID_PARAMETER;
         cr_report_error(cr_ErrorCodes_INVALID_PARAMETER, 
                         "%s: Requested xfer of %d bytes > REACH_BYTES_IN_A_FILE_PACKET (%d).",
@@ -335,120 +1281,192 @@ int pvtCrFile_transfer_data(const cr_FileTransferData *dataTransfer,
         return cr_ErrorCodes_INVALID_PARAMETER;
     }
 
-    sCr_file_xfer_state.bytes_transfered += bytes_to_write;
-    int bytes_remaining_to_write = 
-        sCr_file_xfer_state.transfer_length - sCr_file_xfer_state.bytes_transfered; 
-    // I3_LOG(LOG_MASK_FILES, "fwtd %d bytes, %d remaining of %d.", bytes_to_write,
-    //        bytes_remaining_to_write, sCr_file_xfer_state.transfer_length);
+#if NUM_FILE_REORDER_SLOTS != 0
+    if (sCr_file_xfer->selective_ack)
+        return transfer_data_selective(dataTransfer, response);
+#endif
 
-    int rval = crcb_write_file(sCr_file_xfer_state.file_id,
-                             sCr_file_xfer_state.request_offset,
-                             bytes_to_write,
-                             dataTransfer->message_data.bytes);
-    if (rval != 0)
+    // A damaged packet is not written.  The client resends from retry_offset,
+    // starting a new group of messages.
+    if (dataTransfer->has_packet_crc32 &&
+        (dataTransfer->packet_crc32 != 
+            pvtCr_crc32(0, dataTransfer->message_data.bytes, bytes_to_write)))
     {
-        LOG_ERROR("File write of %d bytes to fid %d failed with error %d", 
-                  bytes_to_write, sCr_file_xfer_state.file_id, rval);
-        response->result = cr_ErrorCodes_WRITE_FAILED;
-        cr_report_error(cr_ErrorCodes_WRITE_FAILED, 
-                        "%s: Requested write of %d bytes for fid %d failed.",
-                        __FUNCTION__, bytes_to_write, sCr_file_xfer_state.transfer_id);
-        pvtCr_watchdog_end_timeout();
-        return cr_ErrorCodes_WRITE_FAILED;
+        LOG_ERROR("At %d, CRC mismatch in message %d.", 
+                  sCr_file_xfer->bytes_transfered, dataTransfer->message_number);
+        response->result = cr_ErrorCodes_CHECKSUM_MISMATCH;
+        response->retry_offset = sCr_file_xfer->request_offset;
+        sprintf(response->error_message,  
+                "At %d, CRC mismatch in message %d.", 
+                (int)sCr_file_xfer->bytes_transfered,
+                (int)dataTransfer->message_number);
+        response->has_transfer_crc32 = true;
+        response->transfer_crc32 = sCr_file_xfer->crc32;
+        ack_rate_loss();
+        ack_rate_window_end();
+        ack_rate_report(response);
+        sCr_file_xfer->messages_until_ack = sCr_file_xfer->messages_per_ack;
+        sCr_file_xfer->message_number = 0;
+        pvtCr_watchdog_stroke_timeout(cr_get_current_ticks());
+        return 0;
     }
 
     // update these before checking for message mismatch
-    if (sCr_file_xfer_state.messages_until_ack != 0)
-        sCr_file_xfer_state.messages_until_ack--;
-    sCr_file_xfer_state.message_number++;
-    sCr_file_xfer_state.request_offset += bytes_to_write;
+    if (sCr_file_xfer->messages_until_ack != 0)
+        sCr_file_xfer->messages_until_ack--;
+    sCr_file_xfer->message_number++;
 
-    if (dataTransfer->message_number != sCr_file_xfer_state.message_number)
+    // A message out of sequence is not written, so the page buffer holds 
+    // only data that follows in order.
+    if (dataTransfer->message_number != sCr_file_xfer->message_number)
     {
-        sCr_file_xfer_state.request_offset -= bytes_to_write;
         LOG_ERROR("At %d, message number mismatch. Got %d, not %d", 
-                  sCr_file_xfer_state.bytes_transfered,
+                  sCr_file_xfer->bytes_transfered,
                   dataTransfer->message_number, 
-                  sCr_file_xfer_state.message_number);
+                  sCr_file_xfer->message_number);
         response->result = cr_ErrorCodes_PACKET_COUNT_ERR;
         // tell the client the offset at which to retry.
-        response->retry_offset = sCr_file_xfer_state.request_offset + sCr_file_xfer_state.bytes_transfered;
+        response->retry_offset = sCr_file_xfer->request_offset + sCr_file_xfer->bytes_transfered;
         sprintf(response->error_message,  
                 "At %d, message number mismatch. Got %d, not %d", 
-                (int)sCr_file_xfer_state.bytes_transfered,
+                (int)sCr_file_xfer->bytes_transfered,
                 (int)dataTransfer->message_number,
-                (int)sCr_file_xfer_state.message_number);
+                (int)sCr_file_xfer->message_number);
         /*
         cr_report_error(cr_ErrorCodes_WRITE_FAILED, 
                         "%s: At %d, message number mismatch. Got %d, not %d", 
-                        __FUNCTION__, sCr_file_xfer_state.bytes_transfered,
-                        dataTransfer->message_number, sCr_file_xfer_state.message_number);
+                        __FUNCTION__, sCr_file_xfer->bytes_transfered,
+                        dataTransfer->message_number, sCr_file_xfer->message_number);
         */
         // if we don't stop this lets me see on error per mismatch
-        sCr_file_xfer_state.message_number = dataTransfer->message_number;
+        sCr_file_xfer->message_number = dataTransfer->message_number;
+        ack_rate_loss();
+        ack_rate_report(response);
+        // The client counts the reported rate from here.
+        if (sCr_file_xfer->adaptive_ack_rate)
+            sCr_file_xfer->messages_until_ack = sCr_file_xfer->messages_per_ack;
         pvtCr_watchdog_stroke_timeout(cr_get_current_ticks());
         return 0; // cr_ErrorCodes_WRITE_FAILED;
     }
 
+    sCr_file_xfer->bytes_transfered += bytes_to_write;
+    // I3_LOG(LOG_MASK_FILES, "fwtd %d bytes, %d remaining of %d.", bytes_to_write,
+    //        sCr_file_xfer->transfer_length - sCr_file_xfer->bytes_transfered, 
+    //        sCr_file_xfer->transfer_length);
+
+    int rval = file_write(sCr_file_xfer->request_offset,
+                          dataTransfer->message_data.bytes,
+                          bytes_to_write);
+    if (rval != 0)
+    {
+        LOG_ERROR("File write of %d bytes to fid %d failed with error %d", 
+                  bytes_to_write, sCr_file_xfer->file_id, rval);
+        response->result = cr_ErrorCodes_WRITE_FAILED;
+        cr_report_error(cr_ErrorCodes_WRITE_FAILED, 
+                        "%s: Requested write of %d bytes for fid %d failed.",
+                        __FUNCTION__, bytes_to_write, sCr_file_xfer->transfer_id);
+        pvtCr_watchdog_end_timeout();
+        return cr_ErrorCodes_WRITE_FAILED;
+    }
+    sCr_file_xfer->request_offset += bytes_to_write;
+    sCr_file_xfer->crc32 = pvtCr_crc32(sCr_file_xfer->crc32,
+                                       dataTransfer->message_data.bytes, 
+                                       bytes_to_write);
+    // The client can compare this with the CRC of what it sent.
+    response->has_transfer_crc32 = true;
+    response->transfer_crc32 = sCr_file_xfer->crc32;
+
 
 
     /*I3_LOG(LOG_MASK_FILES, "fwtd, rem %d. until ack: %d.  num %d.", 
-               bytes_remaining_to_write, sCr_file_xfer_state.messages_until_ack,
-               sCr_file_xfer_state.message_number);*/
+               bytes_remaining_to_write, sCr_file_xfer->messages_until_ack,
+               sCr_file_xfer->message_number);*/
 
     I3_LOG(LOG_MASK_FILES, "fwtd, msg %d. until ack: %d.  num %d.", 
            dataTransfer->message_number, 
-           sCr_file_xfer_state.messages_until_ack,
-           sCr_file_xfer_state.message_number);
+           sCr_file_xfer->messages_until_ack,
+           sCr_file_xfer->message_number);
 
-    if (sCr_file_xfer_state.bytes_transfered >= sCr_file_xfer_state.transfer_length)
-    {
-        I3_LOG(LOG_MASK_ALWAYS, "file write complete.");
-        if (bytes_remaining_to_write != 0)
-        {
-            I3_LOG(LOG_MASK_WARN, "On file write, remaining bytes is below zero.");
-        }
-        response->is_complete = true;
-        crcb_file_transfer_complete(sCr_file_xfer_state.file_id);
-        pvtCr_watchdog_end_timeout();
-        return 0;
-    }
+    if (sCr_file_xfer->bytes_transfered >= sCr_file_xfer->transfer_length)
+        return finish_write(response);
 
-    if (sCr_file_xfer_state.messages_until_ack != 0)
+    if (sCr_file_xfer->messages_until_ack != 0)
     {
         /*
         I3_LOG(LOG_MASK_FILES, "file write, no ACK. per ack: %d.  until ack: %d.  num %d.", 
-               sCr_file_xfer_state.messages_per_ack, sCr_file_xfer_state.messages_until_ack,
-               sCr_file_xfer_state.message_number);
+               sCr_file_xfer->messages_per_ack, sCr_file_xfer->messages_until_ack,
+               sCr_file_xfer->message_number);
          */
         pvtCr_watchdog_stroke_timeout(cr_get_current_ticks());
         return cr_ErrorCodes_NO_RESPONSE;
     }
     // here we want to ack, also reset the counters.
     I3_LOG(LOG_MASK_FILES, "ACK file write.  per ack: %d.  num %d.", 
-               sCr_file_xfer_state.messages_per_ack, sCr_file_xfer_state.message_number);
+               sCr_file_xfer->messages_per_ack, sCr_file_xfer->message_number);
 
-    sCr_file_xfer_state.messages_until_ack = sCr_file_xfer_state.messages_per_ack;
-    sCr_file_xfer_state.message_number = 0;
+    ack_rate_window_end();
+    ack_rate_report(response);
+    sCr_file_xfer->messages_until_ack = sCr_file_xfer->messages_per_ack;
+    sCr_file_xfer->message_number = 0;
     response->is_complete = false;
+    checkpoint_save();
     pvtCr_watchdog_stroke_timeout(cr_get_current_ticks());
     return 0;
 }
 
+// The notification ending a read gives the CRC of all the data sent.  
+// If the client gives its CRC it is checked.
+static void finish_read_crc(const cr_FileTransferDataNotification *request,
+                            cr_FileTransferDataNotification *response)
+{
+    response->has_transfer_crc32 = true;
+    response->transfer_crc32 = sCr_file_xfer->crc32;
+    if (request->has_transfer_crc32 && 
+        (request->transfer_crc32 != sCr_file_xfer->crc32))
+    {
+        LOG_ERROR("File read CRC 0x%x, client has 0x%x.", 
+                  sCr_file_xfer->crc32, request->transfer_crc32);
+        response->result = cr_ErrorCodes_CHECKSUM_MISMATCH;
+    }
+}
+
 int pvtCrFile_transfer_data_notification(const cr_FileTransferDataNotification *request,
                                       cr_FileTransferData *dataTransfer)
 {
+#ifdef INCLUDE_FILE_MAPPED_READS
+    sCr_file_mapped_packet = NULL;
+#endif
+    // A prompt names its transfer.  Continued messages take turns between
+    // the reads that have packets left to send in their windows.
+    cr_FileTransferStateMachine *xfer = 
+        request ? transfer_find(request->transfer_id) : next_read();
     if (!pvtCr_challenge_key_is_valid()) {
-        sCr_file_xfer_state.state = cr_FileTransferState_IDLE; 
+        if (xfer != NULL)
+            xfer->state = cr_FileTransferState_IDLE; 
         pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
         return cr_ErrorCodes_NO_DATA; 
     }
+    if (xfer == NULL)
+    {
+        if (!request)
+        {
+            pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
+            return cr_ErrorCodes_NO_DATA;
+        }
+        LOG_ERROR("No transfer with transfer_id %d", request->transfer_id);
+        cr_report_error(cr_ErrorCodes_INVALID_PARAMETER, 
+                        "%s: No transfer with transfer_id %d.", 
+                        __FUNCTION__, request->transfer_id);
+        dataTransfer->result = cr_ErrorCodes_INVALID_PARAMETER;
+        return cr_ErrorCodes_INVALID_PARAMETER;
+    }
+    sCr_file_xfer = xfer;
 
     // We receive this in the case of read file.
     // And it can generate repeated responses.
     if (request)
     {   // responding to a prompt.
-        switch (sCr_file_xfer_state.state)
+        switch (sCr_file_xfer->state)
         {
         default:
         case cr_FileTransferState_FILE_TRANSFER_INVALID:
@@ -470,7 +1488,8 @@ int pvtCrFile_transfer_data_notification(const cr_FileTransferDataNotification *
             {
                 // echo the notification back
                 memcpy(dataTransfer, request, sizeof(cr_FileTransferDataNotification));
-                sCr_file_xfer_state.state = cr_FileTransferState_IDLE;
+                finish_read_crc(request, (cr_FileTransferDataNotification *)dataTransfer);
+                sCr_file_xfer->state = cr_FileTransferState_IDLE;
                 pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
                 pvtCr_num_remaining_objects = 0;
                 pvtCr_num_continued_objects = 0;
@@ -490,7 +1509,7 @@ int pvtCrFile_transfer_data_notification(const cr_FileTransferDataNotification *
             break;
         }
 
-        if (sCr_file_xfer_state.read_write)
+        if (sCr_file_xfer->read_write)
         {   // expecting read
             LOG_ERROR("Expecting read, not write");
             cr_report_error(cr_ErrorCodes_INVALID_STATE, 
@@ -502,27 +1521,34 @@ int pvtCrFile_transfer_data_notification(const cr_FileTransferDataNotification *
         if (request->is_complete)
         {
             I3_LOG(LOG_MASK_ALWAYS, "file read of fid %d is complete.", 
-                   sCr_file_xfer_state.file_id);
-            sCr_file_xfer_state.state = cr_FileTransferState_COMPLETE;
+                   sCr_file_xfer->file_id);
+            sCr_file_xfer->state = cr_FileTransferState_COMPLETE;
             pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
             pvtCr_num_remaining_objects = 0;
             pvtCr_num_continued_objects = 0;
             dataTransfer->result = 0;
+            // The response is the notification.
+            finish_read_crc(request, (cr_FileTransferDataNotification *)dataTransfer);
             pvtCr_watchdog_end_timeout();
             return 0;
         }
 
         pvtCr_continued_message_type = cr_ReachMessageTypes_TRANSFER_DATA;
-        pvtCr_num_remaining_objects = sCr_file_xfer_state.messages_until_ack;
-        pvtCr_num_continued_objects = sCr_file_xfer_state.messages_per_ack;
-        sCr_file_xfer_state.messages_until_ack = sCr_file_xfer_state.messages_per_ack;
-        sCr_file_xfer_state.message_number = 0;
+        pvtCr_num_remaining_objects = sCr_file_xfer->messages_until_ack;
+        pvtCr_num_continued_objects = sCr_file_xfer->messages_per_ack;
+        sCr_file_xfer->messages_until_ack = sCr_file_xfer->messages_per_ack;
+        sCr_file_xfer->message_number = 0;
+      #ifdef INCLUDE_FILE_COMPRESSION
+        // Each window can be decoded alone.
+        if (sCr_file_xfer->compression == cr_FileCompression_LZSS)
+            pvtCr_lzss_restart();
+      #endif
     }
     memset(dataTransfer, 0, sizeof(cr_FileTransferData));
 
-    dataTransfer->transfer_id = sCr_file_xfer_state.transfer_id;
+    dataTransfer->transfer_id = sCr_file_xfer->transfer_id;
     size_t bytes_remaining_to_read = 
-        sCr_file_xfer_state.transfer_length - sCr_file_xfer_state.bytes_transfered;
+        sCr_file_xfer->transfer_length - sCr_file_xfer->bytes_transfered;
 
     size_t 
         bytes_requested = 
@@ -530,95 +1556,111 @@ int pvtCrFile_transfer_data_notification(const cr_FileTransferDataNotification *
                 ? REACH_BYTES_IN_A_FILE_PACKET : bytes_remaining_to_read;
 
     I3_LOG(LOG_MASK_FILES, "file read %d, %d remaining of %d.", bytes_requested,
-           bytes_remaining_to_read, sCr_file_xfer_state.transfer_length);
+           bytes_remaining_to_read, sCr_file_xfer->transfer_length);
     I3_LOG(LOG_MASK_FILES, " per ack: %d.  until ack: %d.  num %d.", 
-           sCr_file_xfer_state.messages_per_ack, sCr_file_xfer_state.messages_until_ack,
-           sCr_file_xfer_state.message_number);
+           sCr_file_xfer->messages_per_ack, sCr_file_xfer->messages_until_ack,
+           sCr_file_xfer->message_number);
 
+    int rval;
     int bytes_read = 0;
-    int rval = crcb_read_file(sCr_file_xfer_state.file_id,
-                            sCr_file_xfer_state.request_offset,
-                            bytes_requested,
-                            dataTransfer->message_data.bytes,
-                            &bytes_read);
+    const uint8_t *packet = dataTransfer->message_data.bytes;
+#ifdef INCLUDE_FILE_COMPRESSION
+    if (sCr_file_xfer->compression == cr_FileCompression_LZSS)
+    {
+        bytes_read = pvtCr_lzss_encode(dataTransfer->message_data.bytes, 
+                                       REACH_BYTES_IN_A_FILE_PACKET);
+        rval = sCr_lzss_read_error;
+    }
+    else
+#endif
+#ifdef INCLUDE_FILE_MAPPED_READS
+    if (sCr_file_xfer->mapped_data != NULL)
+        rval = read_mapped_data(&packet, bytes_requested, &bytes_read);
+    else
+#endif
+    rval = read_file_data(dataTransfer->message_data.bytes, bytes_requested, &bytes_read);
     if (rval != 0)
     {
         dataTransfer->result = cr_ErrorCodes_READ_FAILED;
         cr_report_error(cr_ErrorCodes_READ_FAILED, 
                         "%s: File read of %d bytes from fid %d failed with error %d", 
-                        __FUNCTION__, bytes_requested, sCr_file_xfer_state.file_id, rval);
+                        __FUNCTION__, bytes_requested, sCr_file_xfer->file_id, rval);
         pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
         pvtCr_num_remaining_objects = 0;
         pvtCr_num_continued_objects = 0;
         pvtCr_watchdog_end_timeout();
         return cr_ErrorCodes_READ_FAILED;
     }
-    dataTransfer->message_data.size = bytes_read;
-    sCr_file_xfer_state.bytes_transfered += bytes_read;
-    sCr_file_xfer_state.request_offset += bytes_read;
+    // A mapped packet leaves message_data empty.
+    if (packet == dataTransfer->message_data.bytes)
+        dataTransfer->message_data.size = bytes_read;
 
-    // To Do:  Calculate CRC.
+    // Each packet carries its own CRC, the total is sent at the end.
+    dataTransfer->has_packet_crc32 = true;
+    dataTransfer->packet_crc32 = pvtCr_crc32(0, packet, bytes_read);
 
-    if (sCr_file_xfer_state.messages_until_ack != 0)
-        sCr_file_xfer_state.messages_until_ack--;
+    if (sCr_file_xfer->messages_until_ack != 0)
+        sCr_file_xfer->messages_until_ack--;
     
-    if (sCr_file_xfer_state.messages_until_ack == 0)
+    if (sCr_file_xfer->messages_until_ack == 0)
     {
         I3_LOG(LOG_MASK_FILES, "file read wait for ACK now.");
     }
     
-    pvtCr_num_remaining_objects = sCr_file_xfer_state.messages_until_ack;
-    pvtCr_num_continued_objects = sCr_file_xfer_state.messages_per_ack;
+    pvtCr_num_remaining_objects = sCr_file_xfer->messages_until_ack;
+    pvtCr_num_continued_objects = sCr_file_xfer->messages_per_ack;
     pvtCr_continued_message_type = pvtCr_num_remaining_objects == 0  ? 
             cr_ReachMessageTypes_INVALID : cr_ReachMessageTypes_TRANSFER_DATA;
 
-    sCr_file_xfer_state.message_number++;
-    dataTransfer->message_number = sCr_file_xfer_state.message_number;
+    sCr_file_xfer->message_number++;
+    dataTransfer->message_number = sCr_file_xfer->message_number;
 
-    bytes_remaining_to_read -= bytes_read;
-    if (bytes_remaining_to_read == 0)
+    bool read_complete = (sCr_file_xfer->bytes_transfered >= 
+                          sCr_file_xfer->transfer_length);
+#ifdef INCLUDE_FILE_COMPRESSION
+    if (sCr_file_xfer->compression == cr_FileCompression_LZSS)
+        read_complete = pvtCr_lzss_done();
+#endif
+    if (read_complete)
     {
         I3_LOG(LOG_MASK_ALWAYS, "File read complete.");
         pvtCr_num_remaining_objects = 0;
-        sCr_file_xfer_state.state = cr_FileTransferState_COMPLETE;
+        sCr_file_xfer->state = cr_FileTransferState_COMPLETE;
         pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
         pvtCr_watchdog_end_timeout();
         return 0;
     }
-    sCr_file_xfer_state.state = cr_FileTransferState_DATA;
+    sCr_file_xfer->state = cr_FileTransferState_DATA;
     pvtCr_watchdog_stroke_timeout(cr_get_current_ticks());
     return 0;
 }
 
 // 
 // Timeout Watchdog interface
-// This is used in the file write sequences.
+// Each file transfer has its own.  These act on the current transfer.
 // 
-static bool  sTimeoutWatchdog_is_active = false;
-static uint32_t sTimeoutWatchdog_period = 0;
-static uint32_t sTimeoutWatchdog_target = 0;
 
 // 0 ms disables watchdog.
 void pvtCr_watchdog_start_timeout(uint32_t msec, uint32_t ticks)
 {
     if (msec > 0) {
-        sTimeoutWatchdog_is_active = true;
-        sTimeoutWatchdog_period    = msec;
-        sTimeoutWatchdog_target = ticks + msec;
+        sCr_file_xfer->watchdog_active = true;
+        sCr_file_xfer->watchdog_period = msec;
+        sCr_file_xfer->watchdog_target = ticks + msec;
         I3_LOG(LOG_MASK_TIMEOUT, "%s: set timeout to %d ms at %d ticks.", __FUNCTION__, msec, ticks);
         return;
     }
     I3_LOG(LOG_MASK_TIMEOUT, "%s: Disable timeout with %d ms at %d ticks.", __FUNCTION__, msec, ticks);
-    sTimeoutWatchdog_is_active = false;
+    sCr_file_xfer->watchdog_active = false;
 }
 
 // resets the timeout period to original
 void pvtCr_watchdog_stroke_timeout(uint32_t ticks)
 {
-    if (sTimeoutWatchdog_is_active) {
-        sTimeoutWatchdog_target = ticks + sTimeoutWatchdog_period;
+    if (sCr_file_xfer->watchdog_active) {
+        sCr_file_xfer->watchdog_target = ticks + sCr_file_xfer->watchdog_period;
         I3_LOG(LOG_MASK_TIMEOUT, "%s: Stroke timeout with %d ms at %d ticks.", 
-               __FUNCTION__, sTimeoutWatchdog_period, ticks);
+               __FUNCTION__, sCr_file_xfer->watchdog_period, ticks);
         return;
     }
     I3_LOG(LOG_MASK_TIMEOUT, "%s: Stroke timeout inactive.", __FUNCTION__);
@@ -627,20 +1669,22 @@ void pvtCr_watchdog_stroke_timeout(uint32_t ticks)
 // disables the watchdog
 void pvtCr_watchdog_end_timeout()
 {
-    sTimeoutWatchdog_is_active = false;
+    sCr_file_xfer->watchdog_active = false;
     I3_LOG(LOG_MASK_TIMEOUT, "%s: End timeout.", __FUNCTION__);
 }
 
-// if active, compares ticks to expected timeout.
-// return 1 if timeout occurred
+// Compares ticks to the timeout of each active watchdog.
+// return 1 if a timeout occurred.  That transfer becomes the current one.
 int pvtCr_watchdog_check_timeout(uint32_t ticks)
 {
-    if (!sTimeoutWatchdog_is_active)
-        return 0;
-
-    if (ticks > sTimeoutWatchdog_target)
+    for (int i = 0; i < NUM_FILE_TRANSFERS; i++)
     {
-        I3_LOG(LOG_MASK_TIMEOUT, TEXT_RED "%s: timeout Expired.", __FUNCTION__);
+        cr_FileTransferStateMachine *xfer = &sCr_file_xfer_table[i];
+        if (!xfer->watchdog_active || (ticks <= xfer->watchdog_target))
+            continue;
+        I3_LOG(LOG_MASK_TIMEOUT, TEXT_RED "%s: timeout Expired for transfer_id %d.", 
+               __FUNCTION__, xfer->transfer_id);
+        sCr_file_xfer = xfer;
         return 1;
     }
     return 0;
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2023-2024 i3 Product Development
+ * 
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/********************************************************************************************
+ *    _ ____  ___             _         _     ___              _                        _
+ *   (_)__ / | _ \_ _ ___  __| |_  _ __| |_  |   \ _____ _____| |___ _ __ _ __  ___ _ _| |_
+ *   | ||_ \ |  _/ '_/ _ \/ _` | || / _|  _| | |) / -_) V / -_) / _ \ '_ \ '  \/ -_) ' \  _|
+ *   |_|___/ |_| |_| \___/\__,_|\_,_\__|\__| |___/\___|\_/\___|_\___/ .__/_|_|_\___|_||_\__|
+ *                                                                  |_|
+ *                           -----------------------------------
+ *                          Copyright i3 Product Development 2023
+ *
+ * \brief LZSS compression of file reads.
+ *
+ ********************************************************************************************/
+
+/**
+ * @file      cr_lzss.c
+ * @brief     A small streaming LZSS compressor used by the file service to 
+ *            compress file reads.  It keeps a 1 KB history and finds repeats
+ *            through hash chains, using about 3.5 KB of RAM.  The format is 
+ *            byte aligned and described with FileCompression in reach.proto.
+ *            The file data is pulled through a read function as needed.  The
+ *            stream can be restarted at any packet so that each ACK window 
+ *            can be decoded alone.  
+ *            The contents can be excluded from the build when 
+ *            INCLUDE_FILE_COMPRESSION is not defined.
+ * @copyright (c) Copyright 2023 i3 Product Development. All Rights Reserved.
+ * The Cygngus Reach firmware stack is shared under an MIT license.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// H file provided by the app to configure the stack.
+#include "reach-server.h"
+
+#include "cr_stack.h"
+#include "cr_private.h"
+
+#ifdef INCLUDE_FILE_COMPRESSION
+
+#define LZSS_WINDOW         1024    // history, a power of two
+#define LZSS_MIN_MATCH      3       // shorter repeats are sent as literals
+#define LZSS_MAX_MATCH      66      // 6 bit length
+#define LZSS_MAX_DISTANCE   (LZSS_WINDOW - LZSS_MAX_MATCH)
+#define LZSS_HASH_SIZE      256
+#define LZSS_CHAIN_DEPTH    16      // candidates tried at each position
+
+// Positions count bytes from the start of the transfer.  The chains hold 
+// their low 16 bits, enough to find distances within the window.
+static uint8_t          sCr_lzss_ring[LZSS_WINDOW];
+static uint16_t         sCr_lzss_head[LZSS_HASH_SIZE];
+static uint16_t         sCr_lzss_prev[LZSS_WINDOW];
+static uint32_t         sCr_lzss_pos;       // the next byte to encode
+static uint32_t         sCr_lzss_end;       // bytes in the ring so far
+static uint32_t         sCr_lzss_start;     // where the stream restarted
+static bool             sCr_lzss_eof;
+static cr_lzss_read_fn  sCr_lzss_read;
+
+#define RING(pos)   sCr_lzss_ring[(pos) & (LZSS_WINDOW - 1)]
+
+static uint32_t lzss_hash(uint32_t pos)
+{
+    return ((RING(pos) << 4) ^ (RING(pos + 1) << 2) ^ RING(pos + 2)) & 
+           (LZSS_HASH_SIZE - 1);
+}
+
+// Keeps up to a full match of data ahead of the position.
+static void lzss_fill(void)
+{
+    while (!sCr_lzss_eof && ((sCr_lzss_end - sCr_lzss_pos) < LZSS_MAX_MATCH))
+    {
+        size_t at   = sCr_lzss_end & (LZSS_WINDOW - 1);
+        size_t room = LZSS_MAX_MATCH - (sCr_lzss_end - sCr_lzss_pos);
+        if (room > LZSS_WINDOW - at)
+            room = LZSS_WINDOW - at;
+        size_t num = sCr_lzss_read(&sCr_lzss_ring[at], room);
+        if (num == 0)
+            sCr_lzss_eof = true;
+        sCr_lzss_end += num;
+    }
+}
+
+static void lzss_insert(uint32_t pos)
+{
+    uint32_t hash = lzss_hash(pos);
+    sCr_lzss_prev[pos & (LZSS_WINDOW - 1)] = sCr_lzss_head[hash];
+    sCr_lzss_head[hash] = (uint16_t)pos;
+}
+
+// Returns the length of the longest earlier match, zero if none.
+static uint32_t lzss_longest_match(uint32_t avail, uint32_t *distance)
+{
+    if (avail < LZSS_MIN_MATCH)
+        return 0;
+    uint32_t max_len  = (avail < LZSS_MAX_MATCH) ? avail : LZSS_MAX_MATCH;
+    uint32_t max_dist = sCr_lzss_pos - sCr_lzss_start;
+    if (max_dist > LZSS_MAX_DISTANCE)
+        max_dist = LZSS_MAX_DISTANCE;
+
+    uint32_t best = 0;
+    uint32_t last = 0;
+    uint16_t cand = sCr_lzss_head[lzss_hash(sCr_lzss_pos)];
+    for (int depth = 0; depth < LZSS_CHAIN_DEPTH; depth++)
+    {
+        // Older entries are further away.  Anything else is stale.
+        uint32_t dist = (uint16_t)((uint16_t)sCr_lzss_pos - cand);
+        if ((dist == 0) || (dist > max_dist) || (dist <= last))
+            break;
+        last = dist;
+
+        uint32_t len = 0;
+        while ((len < max_len) && 
+               (RING(sCr_lzss_pos - dist + len) == RING(sCr_lzss_pos + len)))
+            len++;
+        if (len > best)
+        {
+            best = len;
+            *distance = dist;
+            if (len == max_len)
+                break;
+        }
+        cand = sCr_lzss_prev[cand & (LZSS_WINDOW - 1)];
+    }
+    return best;
+}
+
+/**
+* @brief   pvtCr_lzss_start
+* @details Starts compressing a new stream of data.
+* @param   read Called for more data.  Returns zero at the end.
+*/
+void pvtCr_lzss_start(cr_lzss_read_fn read)
+{
+    sCr_lzss_read  = read;
+    sCr_lzss_pos   = 0;
+    sCr_lzss_end   = 0;
+    sCr_lzss_start = 0;
+    sCr_lzss_eof   = false;
+}
+
+/**
+* @brief   pvtCr_lzss_restart
+* @details The next packet refers to no earlier data, so it and those after 
+*          it can be decoded without the packets before.
+*/
+void pvtCr_lzss_restart(void)
+{
+    sCr_lzss_start = sCr_lzss_pos;
+}
+
+/**
+* @brief   pvtCr_lzss_encode
+* @details Compresses data into one packet.  Groups of items do not span 
+*          packets.
+* @param   out Where the packet goes.
+* @param   max The size of the packet.
+* @return  The number of bytes in the packet.
+*/
+size_t pvtCr_lzss_encode(uint8_t *out, size_t max)
+{
+    size_t   num = 0;
+    size_t   flags = 0;
+    unsigned bit = 8;
+    while (true)
+    {
+        lzss_fill();
+        uint32_t avail = sCr_lzss_end - sCr_lzss_pos;
+        if (avail == 0)
+            break;
+        if (bit == 8)
+        {   // a new group needs its flag byte and room for a copy.
+            if (num + 3 > max)
+                break;
+            flags = num++;
+            out[flags] = 0;
+            bit = 0;
+        }
+        else if (num + 2 > max)
+            break;
+
+        uint32_t dist = 0;
+        uint32_t len = lzss_longest_match(avail, &dist);
+        if (len >= LZSS_MIN_MATCH)
+        {
+            uint32_t code = dist - 1;
+            out[num++] = code & 0xFF;
+            out[num++] = ((code >> 8) << 6) | (len - LZSS_MIN_MATCH);
+        }
+        else
+        {
+            len = 1;
+            out[flags] |= 1 << bit;
+            out[num++] = RING(sCr_lzss_pos);
+        }
+        bit++;
+
+        for (; len > 0; len--)
+        {
+            if (sCr_lzss_pos + LZSS_MIN_MATCH <= sCr_lzss_end)
+                lzss_insert(sCr_lzss_pos);
+            sCr_lzss_pos++;
+        }
+    }
+    return num;
+}
+
+/**
+* @brief   pvtCr_lzss_done
+* @return  true when all of the data has been encoded.
+*/
+bool pvtCr_lzss_done(void)
+{
+    lzss_fill();
+    return sCr_lzss_pos == sCr_lzss_end;
+}
+
+#endif  // def INCLUDE_FILE_COMPRESSION
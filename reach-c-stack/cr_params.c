@@ -88,7 +88,469 @@
     static cr_ParameterNotifyConfig sCr_param_notify_list[NUM_SUPPORTED_PARAM_NOTIFY];
     /// storage of the previous value
     static cr_ParameterValue sCr_last_param_values[NUM_SUPPORTED_PARAM_NOTIFY];
+    /// state of the change triggers of each notification
+    typedef struct {
+        int8_t   direction;     ///< of the last notified change: 1 up, -1 down, 0 none yet
+        int8_t   side;          ///< of the setpoint: 1 above, -1 below, 0 not yet known
+        bool     has_sample;    ///< the start of the rate window is known
+        uint32_t sample_ticks;
+        double   sample;
+    } notify_trigger_t;
+    static notify_trigger_t sCr_notify_triggers[NUM_SUPPORTED_PARAM_NOTIFY];
+    /// A rate of change is measured over at least this many ticks.
+    #define NOTIFY_RATE_WINDOW  (SYS_TICK_RATE/10)
   #endif
+  #if NUM_PENDING_PARAM_WRITES != 0
+    /// writes without response waiting to be applied
+    static cr_ParameterValue sCr_pending_writes[NUM_PENDING_PARAM_WRITES];
+    static uint8_t sCr_num_pending_writes = 0;
+  #endif
+  #if PARAM_JOURNAL_SIZE != 0
+    #if PARAM_JOURNAL_SIZE > REACH_COUNT_PARAMS_IN_REQUEST
+      #error PARAM_JOURNAL_SIZE cannot exceed REACH_COUNT_PARAMS_IN_REQUEST
+    #endif
+    /// The change journal lists changed PID's, oldest first, each tagged with 
+    /// the sequence number of its latest change.
+    typedef struct {
+        uint32_t sequence;
+        uint16_t pid;
+    } journal_entry_t;
+    static journal_entry_t sCr_journal[PARAM_JOURNAL_SIZE];
+    static uint8_t sCr_journal_count = 0;
+    /// sequence number of the latest change.  Zero means no sequence in a
+    /// read request, so the journal starts at one.
+    static uint32_t sCr_journal_seq = 1;
+    /// The newest change dropped from a full journal.
+    static uint32_t sCr_journal_lost_seq = 1;
+    /// The sequence reported in each part of a read, latched when it starts.
+    static uint32_t sCr_journal_read_seq = 1;
+    /// PID's changed since the client's sequence, to be read as a list.
+    static uint32_t sCr_journal_ids[PARAM_JOURNAL_SIZE];
+  #endif  // PARAM_JOURNAL_SIZE != 0
+  #if NUM_DERIVED_PARAMS != 0
+    /// The app's parameters computed from others.
+    static const cr_DerivedParameter *sCr_derived = NULL;
+    static int sCr_num_derived = 0;
+    /// The last computed value of each, valid until an input changes.
+    static cr_ParameterValue sCr_derived_cache[NUM_DERIVED_PARAMS];
+    static bool sCr_derived_valid[NUM_DERIVED_PARAMS];
+    /// Set while computing, to catch a parameter that depends on itself.
+    static bool sCr_derived_busy[NUM_DERIVED_PARAMS];
+    #ifdef INCLUDE_PENDING_PARAM_READS
+    /// A value given to cr_parameter_read_complete(), read as an input.
+    static const cr_ParameterValue *sCr_supplied_value = NULL;
+    static uint32_t sCr_supplied_pid;
+    #endif
+  #endif  // NUM_DERIVED_PARAMS != 0
+  #ifdef INCLUDE_PENDING_PARAM_READS
+    /// A read response held until the app supplies its pending values.
+    static cr_ParameterReadResult sCr_parked_read;
+    static bool sCr_read_is_parked = false;
+    /// One bit for each value of the response still to be supplied.
+    static uint32_t sCr_pending_read_mask = 0;
+    static uint32_t sCr_parked_ticks = 0;
+    /// The transaction state to restore when the response is sent.
+    static cr_ReachMessageTypes sCr_parked_continued_type;
+    static uint32_t sCr_parked_num_objects = 0;
+    static uint32_t sCr_parked_num_remaining = 0;
+  #endif  // def INCLUDE_PENDING_PARAM_READS
+  #ifdef INCLUDE_PARAM_DESCRIPTION_PTR
+    /// Descriptions of a discovery response are encoded from the app's table.
+    static const cr_ParameterInfo *sCr_param_info_ptrs[REACH_COUNT_PARAM_DESC_IN_RESPONSE];
+    #define DESC_SCRATCH    NULL
+  #else
+    /// Descriptions needed only briefly are copied here rather than onto the stack.
+    static cr_ParameterInfo sCr_desc_scratch;
+    #define DESC_SCRATCH    &sCr_desc_scratch
+  #endif  // def INCLUDE_PARAM_DESCRIPTION_PTR
+
+    // Gets the next description in discovery order or NULL at the end.
+    // Without INCLUDE_PARAM_DESCRIPTION_PTR the description is copied to pCopy.
+    static const cr_ParameterInfo *next_description(cr_ParameterInfo *pCopy)
+    {
+      #ifdef INCLUDE_PARAM_DESCRIPTION_PTR
+        (void)pCopy;
+        return crcb_parameter_discover_next_ptr();
+      #else
+        if (crcb_parameter_discover_next(pCopy) != cr_ErrorCodes_NO_ERROR)
+            return NULL;
+        return pCopy;
+      #endif  // def INCLUDE_PARAM_DESCRIPTION_PTR
+    }
+
+    // Gets the description of a parameter or NULL if there is none, 
+    // as for next_description().
+    static const cr_ParameterInfo *find_description(const uint32_t pid, 
+                                                    cr_ParameterInfo *pCopy)
+    {
+      #ifdef INCLUDE_PARAM_DESCRIPTION_PTR
+        (void)pCopy;
+        return crcb_parameter_get_description_ptr(pid);
+      #else
+        crcb_parameter_discover_reset(pid);
+        return next_description(pCopy);
+      #endif  // def INCLUDE_PARAM_DESCRIPTION_PTR
+    }
+
+    // Adds a description to a discovery response.  
+    // pDesc was copied in place unless it is a pointer into the app's table.
+    static void add_description(cr_ParameterInfoResponse *response,
+                                const cr_ParameterInfo *pDesc)
+    {
+      #ifdef INCLUDE_PARAM_DESCRIPTION_PTR
+        sCr_param_info_ptrs[response->parameter_infos_count] = pDesc;
+      #else
+        affirm(pDesc == &response->parameter_infos[response->parameter_infos_count]);
+      #endif  // def INCLUDE_PARAM_DESCRIPTION_PTR
+        response->parameter_infos_count++;
+    }
+
+  #if PARAM_JOURNAL_SIZE != 0
+    // Moves a PID to the end of the journal with a new sequence number.
+    // The oldest entry is dropped when the journal is full.
+    static void journal_note(const uint32_t pid)
+    {
+        int i;
+        for (i=0; i<sCr_journal_count; i++)
+        {
+            if (sCr_journal[i].pid == pid)
+                break;
+        }
+        if (i == sCr_journal_count)
+        {
+            if (sCr_journal_count < PARAM_JOURNAL_SIZE)
+                sCr_journal_count++;
+            else
+                sCr_journal_lost_seq = sCr_journal[i = 0].sequence;
+        }
+        memmove(&sCr_journal[i], &sCr_journal[i+1], 
+                (sCr_journal_count - 1 - i) * sizeof(journal_entry_t));
+        sCr_journal_seq++;
+        sCr_journal[sCr_journal_count - 1].sequence = sCr_journal_seq;
+        sCr_journal[sCr_journal_count - 1].pid = pid;
+    }
+
+    // Empties the journal.  Sequences from before fall outside of it.
+    static void journal_restart(const uint32_t sequence)
+    {
+        uint32_t seq = sCr_journal_seq + 1;
+        if (sequence > seq)
+            seq = sequence;
+        sCr_journal_count = 0;
+        sCr_journal_seq = sCr_journal_lost_seq = seq;
+        I3_LOG(LOG_MASK_PARAMS, "Change journal restarts at %d.", seq);
+    }
+
+    // Lists the PID's changed after the given sequence in sCr_journal_ids.
+    // Returns the count, or -1 if the journal no longer covers the sequence.
+    static int journal_changed_since(const uint32_t sequence)
+    {
+        if ((sequence > sCr_journal_seq) || (sequence < sCr_journal_lost_seq))
+            return -1;
+
+        int count = 0;
+        for (int i=0; i<sCr_journal_count; i++)
+        {
+            if (sCr_journal[i].sequence > sequence)
+                sCr_journal_ids[count++] = sCr_journal[i].pid;
+        }
+        return count;
+    }
+  #endif  // PARAM_JOURNAL_SIZE != 0
+
+  #if NUM_DERIVED_PARAMS != 0
+    // Returns the index of a derived parameter, or -1 if pid is not derived.
+    static int derived_index(const uint32_t pid)
+    {
+        for (int i=0; i<sCr_num_derived; i++)
+        {
+            if (sCr_derived[i].pid == pid)
+                return i;
+        }
+        return -1;
+    }
+
+    static void param_changed(const uint32_t pid);
+
+    // Drops the cached values computed from pid.  Those that were valid 
+    // have changed in turn.
+    static void derived_invalidate(const uint32_t pid)
+    {
+        for (int i=0; i<sCr_num_derived; i++)
+        {
+            if (!sCr_derived_valid[i])
+                continue;
+            for (int j=0; j<sCr_derived[i].num_inputs; j++)
+            {
+                if (sCr_derived[i].input_pids[j] == pid)
+                {
+                    sCr_derived_valid[i] = false;
+                    param_changed(sCr_derived[i].pid);
+                    break;
+                }
+            }
+        }
+    }
+  #endif  // NUM_DERIVED_PARAMS != 0
+
+    // Everything that must follow a change of value.
+    static void param_changed(const uint32_t pid)
+    {
+      #if PARAM_JOURNAL_SIZE != 0
+        journal_note(pid);
+      #endif  // PARAM_JOURNAL_SIZE != 0
+      #if NUM_DERIVED_PARAMS != 0
+        derived_invalidate(pid);
+      #endif  // NUM_DERIVED_PARAMS != 0
+        (void)pid;
+    }
+
+    // Reads a value from the app, or the cache for a derived parameter.
+    static int param_read(const uint32_t pid, cr_ParameterValue *value)
+    {
+      #if NUM_DERIVED_PARAMS != 0
+        int d = derived_index(pid);
+        if (d < 0)
+        {
+          #ifdef INCLUDE_PENDING_PARAM_READS
+            if ((sCr_supplied_value != NULL) && (pid == sCr_supplied_pid))
+            {
+                *value = *sCr_supplied_value;
+                value->parameter_id = pid;
+                return cr_ErrorCodes_NO_ERROR;
+            }
+          #endif  // def INCLUDE_PENDING_PARAM_READS
+            return crcb_parameter_read(pid, value);
+        }
+        if (sCr_derived_valid[d])
+        {
+            *value = sCr_derived_cache[d];
+            return cr_ErrorCodes_NO_ERROR;
+        }
+        if (sCr_derived_busy[d])
+        {
+            LOG_ERROR("Derived PID %d depends on itself.", pid);
+            return cr_ErrorCodes_INVALID_STATE;
+        }
+
+        // The inputs may themselves be derived.
+        const cr_DerivedParameter *pDerived = &sCr_derived[d];
+        cr_ParameterValue inputs[CR_DERIVED_PARAM_MAX_INPUTS];
+        uint32_t timestamp = 0;
+        int rval = cr_ErrorCodes_NO_ERROR;
+        sCr_derived_busy[d] = true;
+        for (int i=0; i<pDerived->num_inputs; i++)
+        {
+            rval = param_read(pDerived->input_pids[i], &inputs[i]);
+            if (rval != cr_ErrorCodes_NO_ERROR)
+                break;
+            if (inputs[i].timestamp > timestamp)
+                timestamp = inputs[i].timestamp;
+        }
+        sCr_derived_busy[d] = false;
+        if (rval != cr_ErrorCodes_NO_ERROR)
+        {
+            // PENDING is computed when the input arrives.  An input that
+            // fails fails the derived value with the same code.
+            if (rval != cr_ErrorCodes_PENDING)
+                I3_LOG(LOG_MASK_PARAMS, "Derived PID %d: input not read (%d).", pid, rval);
+            return rval;
+        }
+        memset(value, 0, sizeof(cr_ParameterValue));
+        rval = pDerived->compute(pid, inputs, value);
+        if (rval != cr_ErrorCodes_NO_ERROR)
+        {
+            // Not reported, as the report would overwrite a response being built.
+            LOG_ERROR("Derived PID %d could not be computed (%d).", pid, rval);
+            return cr_ErrorCodes_READ_FAILED;
+        }
+        value->parameter_id = pid;
+        value->timestamp = timestamp;
+        sCr_derived_cache[d] = *value;
+        sCr_derived_valid[d] = true;
+        I3_LOG(LOG_MASK_PARAMS, "Computed derived PID %d.", pid);
+        return cr_ErrorCodes_NO_ERROR;
+      #else
+        return crcb_parameter_read(pid, value);
+      #endif  // NUM_DERIVED_PARAMS != 0
+    }
+
+    // Passes a write to the app.  Derived parameters cannot be written.
+    static int param_write(const uint32_t pid, const cr_ParameterValue *value)
+    {
+      #if NUM_DERIVED_PARAMS != 0
+        if (derived_index(pid) >= 0)
+        {
+            I3_LOG(LOG_MASK_PARAMS, "Derived PID %d cannot be written.", pid);
+            return cr_ErrorCodes_PERMISSION_DENIED;
+        }
+      #endif  // NUM_DERIVED_PARAMS != 0
+        int rval = crcb_parameter_write(pid, value);
+        if (rval == cr_ErrorCodes_NO_ERROR)
+            param_changed(pid);
+        return rval;
+    }
+
+    // Reads a value into a slot of the response.  A value that the app will
+    // supply later is marked so that the response is held.
+    static int read_value(const uint32_t pid, cr_ParameterReadResult *response,
+                          const pb_size_t slot)
+    {
+        int rval = param_read(pid, &response->values[slot]);
+      #ifdef INCLUDE_PENDING_PARAM_READS
+        if (rval == cr_ErrorCodes_PENDING)
+        {
+            I3_LOG(LOG_MASK_PARAMS, "Read of PID %d is pending.", pid);
+            memset(&response->values[slot], 0, sizeof(cr_ParameterValue));
+            response->values[slot].parameter_id = pid;
+            sCr_pending_read_mask |= (1u << slot);
+            rval = cr_ErrorCodes_NO_ERROR;
+        }
+      #endif  // def INCLUDE_PENDING_PARAM_READS
+        return rval;
+    }
+
+    // A held read owns the parameter walk, so other walks must wait.
+    static bool refuse_while_read_is_parked(void)
+    {
+      #ifdef INCLUDE_PENDING_PARAM_READS
+        if (sCr_read_is_parked)
+        {
+            cr_report_error(cr_ErrorCodes_INVALID_STATE, "A parameter read is pending.");
+            return true;
+        }
+      #endif  // def INCLUDE_PENDING_PARAM_READS
+        return false;
+    }
+
+    /// A selection by range or group.  Listed ID's are kept in 
+    /// sCr_requested_param_array as members of the selection.
+    static bool sCr_select_active = false;
+    static pb_size_t sCr_select_ids_count = 0;
+    static pb_size_t sCr_select_ranges_count = 0;
+    static cr_ParameterRange sCr_select_ranges[REACH_COUNT_PARAM_RANGES];
+    static char sCr_select_group[REACH_PARAM_GROUP_NAME_LEN];
+
+    static bool select_matches(const cr_ParameterInfo *pDesc)
+    {
+        for (int i=0; i<sCr_select_ids_count; i++)
+        {
+            if (sCr_requested_param_array[i] == (int32_t)pDesc->id)
+                return true;
+        }
+        for (int i=0; i<sCr_select_ranges_count; i++)
+        {
+            if ((pDesc->id >= sCr_select_ranges[i].first_id) &&
+                (pDesc->id <= sCr_select_ranges[i].last_id))
+                return true;
+        }
+        if (sCr_select_group[0] != 0)
+            return crcb_parameter_is_in_group(sCr_select_group, pDesc);
+        return false;
+    }
+
+    // Continues the walk of the parameter table to the next selected parameter.
+    // Returns NULL at the end.  See next_description() for pCopy.
+    static const cr_ParameterInfo *select_next(cr_ParameterInfo *pCopy)
+    {
+        while (true)
+        {
+            const cr_ParameterInfo *pDesc = next_description(pCopy);
+            if ((pDesc == NULL) || select_matches(pDesc))
+                return pDesc;
+        }
+    }
+
+    // Captures the selectors of a request for select_matches().
+    static void select_capture(const uint32_t *ids, pb_size_t ids_count,
+                               const cr_ParameterRange *ranges, pb_size_t ranges_count,
+                               const char *group_name)
+    {
+        memset(sCr_requested_param_array, -1, sizeof(sCr_requested_param_array));
+        for (int i=0; i < ids_count; i++) {
+            affirm(ids[i] < MAX_NUM_PARAM_ID);
+            sCr_requested_param_array[i] = ids[i];
+        }
+        sCr_select_ids_count = ids_count;
+        affirm(ranges_count <= REACH_COUNT_PARAM_RANGES);
+        memcpy(sCr_select_ranges, ranges, ranges_count * sizeof(cr_ParameterRange));
+        sCr_select_ranges_count = ranges_count;
+        strncpy(sCr_select_group, group_name, sizeof(sCr_select_group));
+        sCr_select_group[sizeof(sCr_select_group)-1] = 0;
+    }
+
+    // Captures the selectors of a request and counts the selected parameters.
+    // Returns false if the request does not use ranges or groups.
+    static bool select_init(const uint32_t *ids, pb_size_t ids_count,
+                            const cr_ParameterRange *ranges, pb_size_t ranges_count,
+                            const char *group_name)
+    {
+        sCr_select_active = (ranges_count != 0) || (group_name[0] != 0);
+        if (!sCr_select_active)
+            return false;
+        select_capture(ids, ids_count, ranges, ranges_count, group_name);
+
+        // The header reports the number of objects, so count them first.
+        int count = 0;
+        crcb_parameter_discover_reset(0);
+        while (select_next(DESC_SCRATCH) != NULL)
+            count++;
+        crcb_parameter_discover_reset(0);
+
+        I3_LOG(LOG_MASK_PARAMS, "Selected %d params by %d ranges, group '%s'.", 
+               count, ranges_count, sCr_select_group);
+        pvtCr_num_continued_objects = 
+            pvtCr_num_remaining_objects = count;
+        return true;
+    }
+
+    // Serves the next descriptions of a selection.
+    static int discover_selection(cr_ParameterInfoResponse *response)
+    {
+        response->parameter_infos_count = 0;
+        while ((response->parameter_infos_count < REACH_COUNT_PARAM_DESC_IN_RESPONSE) &&
+               (pvtCr_num_remaining_objects > 0))
+        {
+            const cr_ParameterInfo *pDesc = 
+                select_next(&response->parameter_infos[response->parameter_infos_count]);
+            if (pDesc == NULL)
+            {
+                pvtCr_num_remaining_objects = 0;
+                break;
+            }
+            pvtCr_num_remaining_objects--;
+            add_description(response, pDesc);
+        }
+        pvtCr_continued_message_type = (pvtCr_num_remaining_objects == 0) ? 
+            cr_ReachMessageTypes_INVALID : cr_ReachMessageTypes_DISCOVER_PARAMETERS;
+        if (response->parameter_infos_count == 0)
+            return cr_ErrorCodes_NO_DATA; 
+        return 0;
+    }
+
+    // Serves the next values of a selection.
+    static int read_selection(cr_ParameterReadResult *response)
+    {
+        response->values_count = 0;
+        while ((response->values_count < REACH_COUNT_PARAM_READ_VALUES) &&
+               (pvtCr_num_remaining_objects > 0))
+        {
+            const cr_ParameterInfo *pDesc = select_next(DESC_SCRATCH);
+            if (pDesc == NULL)
+            {
+                pvtCr_num_remaining_objects = 0;
+                break;
+            }
+            read_value(pDesc->id, response, response->values_count);
+            pvtCr_num_remaining_objects--;
+            response->values_count++;
+        }
+        pvtCr_continued_message_type = (pvtCr_num_remaining_objects == 0) ? 
+            cr_ReachMessageTypes_INVALID : cr_ReachMessageTypes_READ_PARAMETERS;
+        if (response->values_count == 0)
+            return cr_ErrorCodes_NO_DATA; 
+        return 0;
+    }
 
 
     /**
@@ -107,8 +569,6 @@
     pvtCrParam_discover_parameters(const cr_ParameterInfoRequest *request,
                                    cr_ParameterInfoResponse *response)
     {
-        int rval;
-
         if (!pvtCr_challenge_key_is_valid()) {
             sCr_requested_param_info_count = 0;
             pvtCr_num_continued_objects = 0;
@@ -122,9 +582,20 @@
         // If specified, not all parameters may be available.
         #endif
 
+        if ((request == NULL) && sCr_select_active)
+            return discover_selection(response);
+
         if (request != NULL) {
             // request will be null on repeated calls.
             // Here implies we are responding to the initial request.
+            if (refuse_while_read_is_parked())
+                return cr_ErrorCodes_INVALID_STATE;
+            if (select_init(request->parameter_ids, request->parameter_ids_count,
+                            request->ranges, request->ranges_count, 
+                            request->group_name))
+            {
+                return discover_selection(response);
+            }
             sCr_requested_param_index = 0;
             sCr_requested_param_info_count = request->parameter_ids_count;
             I3_LOG(LOG_MASK_PARAMS, "discover params, count %d.", sCr_requested_param_info_count);
@@ -173,8 +644,8 @@
             response->parameter_infos_count = 0;
             for (int i=0; i<REACH_COUNT_PARAM_DESC_IN_RESPONSE; i++) 
             {
-                rval = crcb_parameter_discover_next(&response->parameter_infos[i]);
-                if (rval != cr_ErrorCodes_NO_ERROR) 
+                const cr_ParameterInfo *pDesc = next_description(&response->parameter_infos[i]);
+                if (pDesc == NULL) 
                 {   // there are no more params.  clear on last.
                     pvtCr_num_remaining_objects = 0;
                     if (i==0)
@@ -188,7 +659,7 @@
                 I3_LOG(LOG_MASK_PARAMS, "Add param %d.", sCr_requested_param_index);
                 sCr_requested_param_index++;
                 pvtCr_num_remaining_objects--;
-                response->parameter_infos_count++;
+                add_description(response, pDesc);
             }
             if (response->parameter_infos_count == 0)
             {
@@ -217,10 +688,11 @@
             }
             I3_LOG(LOG_MASK_PARAMS, "Add param %d from list of %d", 
                    sCr_requested_param_index, sCr_requested_param_info_count);
-            crcb_parameter_discover_reset(sCr_requested_param_array[sCr_requested_param_index]);
-            rval = crcb_parameter_discover_next(&response->parameter_infos[i]);
+            const cr_ParameterInfo *pDesc = 
+                find_description(sCr_requested_param_array[sCr_requested_param_index],
+                                 &response->parameter_infos[i]);
             sCr_requested_param_array[sCr_requested_param_index] = -1;
-            if (rval != cr_ErrorCodes_NO_ERROR) {
+            if (pDesc == NULL) {
                 // we've done them all.
                 pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
                 sCr_requested_param_info_count = 0;
@@ -228,7 +700,7 @@
             }
             sCr_requested_param_index++;
             pvtCr_num_remaining_objects--;
-            response->parameter_infos_count++;
+            add_description(response, pDesc);
         }
 
         if (response->parameter_infos_count == 0)
@@ -239,6 +711,34 @@
         return 0;
     }
 
+    /**
+    * @brief   pvtCrParam_encode_param_info_response
+    * @details Encodes a discovery response.  With INCLUDE_PARAM_DESCRIPTION_PTR
+    *          the descriptions are encoded directly from the application's 
+    *          table, as they were not copied into the response.
+    * @return  true on success.
+    */
+    bool 
+    pvtCrParam_encode_param_info_response(pb_ostream_t *os_stream,
+                                          const cr_ParameterInfoResponse *response)
+    {
+      #ifdef INCLUDE_PARAM_DESCRIPTION_PTR
+        // This matches the encoding of the repeated parameter_infos field.
+        for (int i=0; i<response->parameter_infos_count; i++)
+        {
+            if (!pb_encode_tag(os_stream, PB_WT_STRING, 
+                               cr_ParameterInfoResponse_parameter_infos_tag))
+                return false;
+            if (!pb_encode_submessage(os_stream, cr_ParameterInfo_fields, 
+                                      sCr_param_info_ptrs[i]))
+                return false;
+        }
+        return true;
+      #else
+        return pb_encode(os_stream, cr_ParameterInfoResponse_fields, response);
+      #endif  // def INCLUDE_PARAM_DESCRIPTION_PTR
+    }
+
     /**
     * @brief   pvtCrParam_discover_parameters_ex
     * @details Private function gandles extended parameter data describing enums and
@@ -375,20 +875,10 @@
     }
 
 
-    // This can be called directly in response to the read request
-    // or it can be called on a continuing basis to complete the 
-    // read transaction.  
-    int pvtCrParam_read_param(const cr_ParameterRead *request,
-                              cr_ParameterReadResult *response) 
+    // Fills a read response with the next values of the transaction.
+    static int read_values(const cr_ParameterRead *request,
+                           cr_ParameterReadResult *response) 
     {
-        if (!pvtCr_challenge_key_is_valid()) {
-            pvtCr_num_continued_objects = 
-                    pvtCr_num_remaining_objects = 0;
-            memset(response, 0, sizeof(cr_ParameterReadResult));
-            pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
-            return cr_ErrorCodes_NO_DATA; 
-        }
-
         #ifdef APP_REQUIRED_PARAMETER_KEY
         // No support yet for the paramter_key
         // To Do:  Handle parameter_key.
@@ -396,25 +886,62 @@
         #endif
 
         int rval;
+        if ((request == NULL) && sCr_select_active)
+            return read_selection(response);
+
         if (request != NULL) {
             // request will be null on repeated calls.
             // Here implies we are responding to the initial request.
-            sCr_requested_param_read_count = request->parameter_ids_count;
+            // The read must reflect any writes without response.
+            pvtCrParam_apply_pending_writes();
+            const uint32_t *ids = request->parameter_ids;
+            pb_size_t ids_count = request->parameter_ids_count;
+            bool changed_only = false;
+          #if PARAM_JOURNAL_SIZE != 0
+            if (request->read_after_timestamp != 0)
+            {
+                // Read only what changed since the client's sequence.
+                // If the journal has lost track, all are read.
+                int changed = journal_changed_since(request->read_after_timestamp);
+                I3_LOG(LOG_MASK_PARAMS, "read changed since %d: %d.", 
+                       request->read_after_timestamp, changed);
+                changed_only = true;
+                sCr_select_active = false;
+                if (changed == 0)
+                {
+                    pvtCr_num_continued_objects = 
+                        pvtCr_num_remaining_objects = 0;
+                    pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
+                    response->values_count = 0;
+                    return 0;
+                }
+                ids = sCr_journal_ids;
+                ids_count = (changed > 0) ? changed : 0;
+            }
+          #endif  // PARAM_JOURNAL_SIZE != 0
+            if (!changed_only && 
+                select_init(request->parameter_ids, request->parameter_ids_count,
+                            request->ranges, request->ranges_count, 
+                            request->group_name))
+            {
+                return read_selection(response);
+            }
+            sCr_requested_param_read_count = ids_count;
             I3_LOG(LOG_MASK_PARAMS, "read params, count %d.", sCr_requested_param_info_count);
 
-            if (request->parameter_ids_count != 0) {
+            if (ids_count != 0) {
                 // init them all to -1 meaning invalid.
                 sCr_requested_param_index = 0;
                 memset(sCr_requested_param_array, -1, sizeof(sCr_requested_param_array));
                 // copy the requested numbers
-                for (int i=0; i < request->parameter_ids_count; i++) {
-                    affirm(request->parameter_ids[i] < MAX_NUM_PARAM_ID);
-                    sCr_requested_param_array[i] = request->parameter_ids[i];
+                for (int i=0; i < ids_count; i++) {
+                    affirm(ids[i] < MAX_NUM_PARAM_ID);
+                    sCr_requested_param_array[i] = ids[i];
                 }
                 // default on first.
                 pvtCr_continued_message_type = cr_ReachMessageTypes_READ_PARAMETERS;
                 pvtCr_num_continued_objects = 
-                    pvtCr_num_remaining_objects = request->parameter_ids_count;
+                    pvtCr_num_remaining_objects = ids_count;
             }
             else
             {
@@ -444,11 +971,9 @@
             response->values_count = 0;
             for (int i=0; i<REACH_COUNT_PARAM_READ_VALUES; i++) 
             {
-                // Would use less stack if we got a pointer into flash instead of the actual data.
-                // But that makes other calls more complicated. 
-                cr_ParameterInfo paramInfo;
-                rval = crcb_parameter_discover_next(&paramInfo);
-                if (rval != cr_ErrorCodes_NO_ERROR) 
+                // Only the ID is needed.  See INCLUDE_PARAM_DESCRIPTION_PTR.
+                const cr_ParameterInfo *pDesc = next_description(DESC_SCRATCH);
+                if (pDesc == NULL) 
                 {   // there are no more params.  clear on last.
                     pvtCr_num_remaining_objects = 0;
                     if (i==0)
@@ -460,7 +985,7 @@
                     I3_LOG(LOG_MASK_PARAMS, "Added read %d.", response->values_count);
                     return 0;
                 }
-                crcb_parameter_read(paramInfo.id, &response->values[i]);
+                read_value(pDesc->id, response, i);
                 I3_LOG(LOG_MASK_PARAMS, "Add param read %d.", sCr_requested_param_index);
                 sCr_requested_param_index++;
                 pvtCr_num_remaining_objects--;
@@ -492,15 +1017,13 @@
             }
             I3_LOG(LOG_MASK_PARAMS, "Read param %d from list of %d", 
                    sCr_requested_param_index, sCr_requested_param_read_count);
-            cr_ParameterValue paramVal;
-            rval = crcb_parameter_read(sCr_requested_param_array[sCr_requested_param_index], &paramVal);
+            rval = read_value(sCr_requested_param_array[sCr_requested_param_index], response, i);
             if (rval != cr_ErrorCodes_NO_ERROR) {
                 // we've done them all.
                 pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
                 sCr_requested_param_read_count = 0;
                 break;
             }
-            response->values[i] = paramVal;
             sCr_requested_param_array[sCr_requested_param_index] = -1;
             sCr_requested_param_index++;
             pvtCr_num_remaining_objects--;
@@ -515,6 +1038,132 @@
         return 0;
     }
 
+    // This can be called directly in response to the read request
+    // or it can be called on a continuing basis to complete the 
+    // read transaction.  
+    // Returns cr_ErrorCodes_PENDING when the response is held for values 
+    // that the app will supply later.  It is then sent by cr_process().
+    int pvtCrParam_read_param(const cr_ParameterRead *request,
+                              cr_ParameterReadResult *response) 
+    {
+        if (!pvtCr_challenge_key_is_valid()) {
+            pvtCr_num_continued_objects = 
+                    pvtCr_num_remaining_objects = 0;
+            memset(response, 0, sizeof(cr_ParameterReadResult));
+            pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
+            return cr_ErrorCodes_NO_DATA; 
+        }
+        if ((request != NULL) && refuse_while_read_is_parked())
+            return cr_ErrorCodes_INVALID_STATE;
+
+      #ifdef INCLUDE_PENDING_PARAM_READS
+        sCr_pending_read_mask = 0;
+      #endif  // def INCLUDE_PENDING_PARAM_READS
+      #if PARAM_JOURNAL_SIZE != 0
+        // Values that change during a multi-part read are noted after this 
+        // sequence, so every part reports it.
+        if (request != NULL)
+            sCr_journal_read_seq = sCr_journal_seq;
+      #endif  // PARAM_JOURNAL_SIZE != 0
+        int rval = read_values(request, response);
+      #if PARAM_JOURNAL_SIZE != 0
+        // The client reads changes after this sequence next time.
+        response->read_timestamp = sCr_journal_read_seq;
+      #endif  // PARAM_JOURNAL_SIZE != 0
+
+      #ifdef INCLUDE_PENDING_PARAM_READS
+        if ((rval != 0) || (sCr_pending_read_mask == 0))
+            return rval;
+
+        // Hold the response and let other prompts through until it is complete.
+        sCr_parked_read = *response;
+        sCr_parked_ticks = cr_get_current_ticks();
+        sCr_parked_continued_type = pvtCr_continued_message_type;
+        sCr_parked_num_objects = pvtCr_num_continued_objects;
+        sCr_parked_num_remaining = pvtCr_num_remaining_objects;
+        sCr_read_is_parked = true;
+        pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
+        I3_LOG(LOG_MASK_PARAMS, "Read response held, pending 0x%x.", sCr_pending_read_mask);
+        return cr_ErrorCodes_PENDING;
+      #else
+        return rval;
+      #endif  // def INCLUDE_PENDING_PARAM_READS
+    }
+
+  #ifdef INCLUDE_PENDING_PARAM_READS
+    /**
+    * @brief   pvtCrParam_resume_read
+    * @details Called by cr_process() to complete a held read response.  A 
+    *          response that waits too long is abandoned with an error report.
+    * @param   response The held response is copied here when it is complete.
+    * @return  cr_ErrorCodes_NO_ERROR if the response is ready to be sent, 
+    *          otherwise cr_ErrorCodes_NO_DATA.
+    */
+    int pvtCrParam_resume_read(cr_ParameterReadResult *response)
+    {
+        if (!sCr_read_is_parked)
+            return cr_ErrorCodes_NO_DATA;
+
+        if (sCr_pending_read_mask != 0)
+        {
+            if ((cr_get_current_ticks() - sCr_parked_ticks) < PENDING_PARAM_READ_TIMEOUT_MS)
+                return cr_ErrorCodes_NO_DATA;
+            sCr_read_is_parked = false;
+            cr_report_error(cr_ErrorCodes_READ_FAILED, 
+                            "Pending parameter read timed out, mask 0x%x.", 
+                            sCr_pending_read_mask);
+            return cr_ErrorCodes_NO_DATA;
+        }
+
+        *response = sCr_parked_read;
+        sCr_read_is_parked = false;
+        pvtCr_continued_message_type = sCr_parked_continued_type;
+        pvtCr_num_continued_objects = sCr_parked_num_objects;
+        pvtCr_num_remaining_objects = sCr_parked_num_remaining;
+        I3_LOG(LOG_MASK_PARAMS, "Held read response complete.");
+        return cr_ErrorCodes_NO_ERROR;
+    }
+  #endif  // def INCLUDE_PENDING_PARAM_READS
+
+    // Writes one value, reporting any failure as there is no response.
+    // This can run while a response is being built in the buffer that 
+    // cr_report_error() uses, so the report is built here.
+    static void apply_write_without_response(const cr_ParameterValue *value)
+    {
+        int rval = param_write(value->parameter_id, value);
+        if (rval != cr_ErrorCodes_NO_ERROR) {
+            cr_ErrorReport err;
+            err.result_value = cr_ErrorCodes_WRITE_FAILED;
+            snprintf(err.result_string, sizeof(err.result_string),
+                     "Error %d: Parameter write without response of ID %d failed (%d).", 
+                     cr_ErrorCodes_WRITE_FAILED, (int)value->parameter_id, rval);
+            crcb_notify_error(&err);
+            LOG_ERROR("%s", err.result_string);
+        }
+    }
+
+    // Holds a write without response until the stack is idle.  
+    // A newer value replaces one pending for the same PID.
+    static void queue_write_without_response(const cr_ParameterValue *value)
+    {
+      #if NUM_PENDING_PARAM_WRITES != 0
+        for (int i=0; i<sCr_num_pending_writes; i++)
+        {
+            if (sCr_pending_writes[i].parameter_id == value->parameter_id)
+            {
+                I3_LOG(LOG_MASK_PARAMS, "Replace pending write of PID %d", value->parameter_id);
+                sCr_pending_writes[i] = *value;
+                return;
+            }
+        }
+        if (sCr_num_pending_writes >= NUM_PENDING_PARAM_WRITES)
+            pvtCrParam_apply_pending_writes();
+        sCr_pending_writes[sCr_num_pending_writes++] = *value;
+      #else
+        apply_write_without_response(value);
+      #endif  // NUM_PENDING_PARAM_WRITES != 0
+    }
+
     int pvtCrParam_write_param(const cr_ParameterWrite *request,
                                cr_ParameterWriteResult *response) 
     {
@@ -535,7 +1184,6 @@
         int rval;
         affirm(request);
         affirm(response);
-        response->result = 0;
         switch (request->values_count)
         {
         case 1: // see NUM_PARAM_WRITE_IN_REQUEST
@@ -548,11 +1196,23 @@
             return cr_ErrorCodes_INVALID_PARAMETER; 
         }
 
+        if (request->write_without_response)
+        {
+            // Failures are reported asynchronously.
+            for (int i=0; i<request->values_count; i++)
+                queue_write_without_response(&request->values[i]);
+            return cr_ErrorCodes_NO_RESPONSE;
+        }
+
+        // Apply earlier writes first so that they are not applied over this.
+        pvtCrParam_apply_pending_writes();
+        response->result = 0;
+
         // we are supplied a list of params.
         for (int i=0; i<request->values_count; i++)
         {
             I3_LOG(LOG_MASK_PARAMS, "%s(): Write param[%d] id %d", __FUNCTION__, i, request->values[i].parameter_id);
-            rval = crcb_parameter_write(request->values[i].parameter_id, &request->values[i]);
+            rval = param_write(request->values[i].parameter_id, &request->values[i]);
             if (rval != cr_ErrorCodes_NO_ERROR) {
                 cr_report_error(cr_ErrorCodes_WRITE_FAILED, "Parameter write of ID %d failed.", request->values[i].parameter_id);
                 return cr_ErrorCodes_WRITE_FAILED;
@@ -561,10 +1221,236 @@
         return 0;
     }
 
+  #ifdef INCLUDE_LARGE_PARAMETERS
+    // The read being served in chunks.
+    static uint32_t sCr_large_read_pid = 0;
+    static uint32_t sCr_large_read_offset = 0;
+    static uint32_t sCr_large_read_end = 0;
+    // The write being received in chunks.
+    static bool     sCr_large_write_active = false;
+    static uint32_t sCr_large_write_pid = 0;
+    static uint32_t sCr_large_write_offset = 0;
+    static uint32_t sCr_large_write_total = 0;
+
+    // Returns cr_ErrorCodes_NO_ERROR if pid is a LARGE_BYTES parameter.
+    static int check_large_param(const uint32_t pid)
+    {
+      #ifndef INCLUDE_PARAM_DESCRIPTION_PTR
+        // Without the pointer the description is found by moving the walk.
+        if (refuse_while_read_is_parked())
+            return cr_ErrorCodes_INVALID_STATE;
+      #endif  // ndef INCLUDE_PARAM_DESCRIPTION_PTR
+        const cr_ParameterInfo *pDesc = find_description(pid, DESC_SCRATCH);
+        if (pDesc == NULL)
+        {
+            cr_report_error(cr_ErrorCodes_INVALID_PARAMETER, "Large parameter %d not found.", pid);
+            return cr_ErrorCodes_INVALID_PARAMETER;
+        }
+        if (pDesc->data_type != cr_ParameterDataType_LARGE_BYTES)
+        {
+            cr_report_error(cr_ErrorCodes_INVALID_PARAMETER, "Parameter %d is not LARGE_BYTES.", pid);
+            return cr_ErrorCodes_INVALID_PARAMETER;
+        }
+        return cr_ErrorCodes_NO_ERROR;
+    }
+
+    /**
+    * @brief   pvtCrParam_read_large_param
+    * @details Serves a READ_LARGE_PARAM request as a continued transaction, 
+    *          one chunk of up to REACH_LARGE_PARAM_CHUNK_LEN bytes per 
+    *          response.  The number of objects in the header is the number of
+    *          chunks.
+    * @param   request The decoded request, or NULL to continue.
+    * @param   response The next chunk.
+    * @return  cr_ErrorCodes_NO_ERROR or an error.
+    */
+    int pvtCrParam_read_large_param(const cr_LargeParameterRead *request,
+                                    cr_LargeParameterData *response)
+    {
+        int rval;
+        size_t len;
+        uint32_t total;
+
+        if (!pvtCr_challenge_key_is_valid()) {
+            pvtCr_num_continued_objects = 
+                    pvtCr_num_remaining_objects = 0;
+            pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
+            return cr_ErrorCodes_NO_DATA; 
+        }
+
+        if (request != NULL)
+        {
+            rval = check_large_param(request->parameter_id);
+            if (rval != cr_ErrorCodes_NO_ERROR)
+                return rval;
+
+            // Learn the size, to count the chunks.
+            len = 0;
+            rval = crcb_parameter_read_large(request->parameter_id, 0, 
+                                             response->data.bytes, &len, &total);
+            if (rval != cr_ErrorCodes_NO_ERROR)
+            {
+                cr_report_error(cr_ErrorCodes_READ_FAILED, "Large parameter %d read failed.", 
+                                request->parameter_id);
+                return cr_ErrorCodes_READ_FAILED;
+            }
+            if (request->offset > total)
+            {
+                cr_report_error(cr_ErrorCodes_INVALID_PARAMETER, "Offset %d beyond the %d bytes of %d.", 
+                                request->offset, total, request->parameter_id);
+                return cr_ErrorCodes_INVALID_PARAMETER;
+            }
+            sCr_large_read_pid    = request->parameter_id;
+            sCr_large_read_offset = request->offset;
+            sCr_large_read_end    = total;
+            if ((request->length != 0) && (request->length < (total - request->offset)))
+                sCr_large_read_end = request->offset + request->length;
+
+            // An empty value is still sent once.
+            uint32_t chunks = (sCr_large_read_end - sCr_large_read_offset + 
+                               REACH_LARGE_PARAM_CHUNK_LEN - 1) / REACH_LARGE_PARAM_CHUNK_LEN;
+            pvtCr_num_continued_objects = 
+                pvtCr_num_remaining_objects = (chunks == 0) ? 1 : chunks;
+        }
+
+        len = sCr_large_read_end - sCr_large_read_offset;
+        if (len > REACH_LARGE_PARAM_CHUNK_LEN)
+            len = REACH_LARGE_PARAM_CHUNK_LEN;
+        response->parameter_id = sCr_large_read_pid;
+        response->offset = sCr_large_read_offset;
+        rval = crcb_parameter_read_large(sCr_large_read_pid, sCr_large_read_offset,
+                                         response->data.bytes, &len, &total);
+        if (rval != cr_ErrorCodes_NO_ERROR)
+        {
+            pvtCr_num_remaining_objects = 0;
+            pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
+            cr_report_error(cr_ErrorCodes_READ_FAILED, "Large parameter %d read failed at %d.", 
+                            sCr_large_read_pid, sCr_large_read_offset);
+            return cr_ErrorCodes_READ_FAILED;
+        }
+        response->data.size = len;
+        response->total_size = total;
+        sCr_large_read_offset += len;
+
+        pvtCr_num_remaining_objects--;
+        // The value may have shrunk while being read.
+        if ((len == 0) || (sCr_large_read_offset >= sCr_large_read_end))
+            pvtCr_num_remaining_objects = 0;
+        pvtCr_continued_message_type = (pvtCr_num_remaining_objects == 0) ? 
+            cr_ReachMessageTypes_INVALID : cr_ReachMessageTypes_READ_LARGE_PARAM;
+        return cr_ErrorCodes_NO_ERROR;
+    }
+
+    /**
+    * @brief   pvtCrParam_write_large_param
+    * @details Passes one chunk of a WRITE_LARGE_PARAM to the app.  Chunks must
+    *          arrive in order.  A chunk at offset zero starts a new value, 
+    *          abandoning any incomplete one.  The response gives the result
+    *          and the offset expected next so that a client can resume after
+    *          an error.
+    * @param   request The decoded chunk.
+    * @param   response Reports progress.
+    * @return  cr_ErrorCodes_NO_ERROR or an error.
+    */
+    int pvtCrParam_write_large_param(const cr_LargeParameterWrite *request,
+                                     cr_LargeParameterWriteResult *response)
+    {
+        if (!pvtCr_challenge_key_is_valid()) {
+            memset(response, 0, sizeof(cr_LargeParameterWriteResult));
+            return cr_ErrorCodes_NO_DATA; 
+        }
+
+        // Errors are reported before the response is filled, as the report
+        // shares its buffer.
+        int rval = check_large_param(request->parameter_id);
+        if (rval != cr_ErrorCodes_NO_ERROR)
+        {
+            sCr_large_write_active = false;
+        }
+        else if (request->offset == 0)
+        {
+            sCr_large_write_active = true;
+            sCr_large_write_pid    = request->parameter_id;
+            sCr_large_write_offset = 0;
+            sCr_large_write_total  = request->total_size;
+        }
+        else if (!sCr_large_write_active || 
+                 (request->parameter_id != sCr_large_write_pid) ||
+                 (request->total_size != sCr_large_write_total) ||
+                 (request->offset != sCr_large_write_offset))
+        {
+            rval = cr_ErrorCodes_INVALID_STATE;
+            cr_report_error(rval, "Large write of %d out of sequence at %d.", 
+                            request->parameter_id, request->offset);
+        }
+
+        if ((rval == cr_ErrorCodes_NO_ERROR) && 
+            ((request->offset + request->data.size) > request->total_size))
+        {
+            rval = cr_ErrorCodes_INVALID_PARAMETER;
+            cr_report_error(rval, "Large write of %d beyond its %d bytes.", 
+                            request->parameter_id, request->total_size);
+        }
+
+        if (rval == cr_ErrorCodes_NO_ERROR)
+        {
+            rval = crcb_parameter_write_large(request->parameter_id, request->offset,
+                                              request->data.bytes, request->data.size,
+                                              request->total_size);
+            if (rval != cr_ErrorCodes_NO_ERROR)
+            {
+                sCr_large_write_active = false;
+                cr_report_error(rval, "Large write of %d failed at %d.", 
+                                request->parameter_id, request->offset);
+            }
+            else
+            {
+                sCr_large_write_offset += request->data.size;
+            }
+        }
+
+        memset(response, 0, sizeof(cr_LargeParameterWriteResult));
+        response->result = rval;
+        response->parameter_id = request->parameter_id;
+        response->offset = sCr_large_write_active ? sCr_large_write_offset : 0;
+        if ((rval == cr_ErrorCodes_NO_ERROR) && 
+            (sCr_large_write_offset == sCr_large_write_total))
+        {
+            sCr_large_write_active = false;
+            response->is_complete = true;
+            param_changed(request->parameter_id);
+            I3_LOG(LOG_MASK_PARAMS, "Large parameter %d written, %d bytes.", 
+                   request->parameter_id, sCr_large_write_total);
+        }
+        // The result is in the response.
+        return cr_ErrorCodes_NO_ERROR;
+    }
+  #endif  // def INCLUDE_LARGE_PARAMETERS
+
   #if NUM_SUPPORTED_PARAM_NOTIFY != 0
 
     static cr_ParameterNotifyConfig sCr_param_notify_list[NUM_SUPPORTED_PARAM_NOTIFY];
 
+    // Finds the slot holding an enabled notification of a PID, or else a free
+    // slot.  Returns -1 if all are in use.
+    static int notify_find_slot(const uint32_t pid, bool *pExisting)
+    {
+        int free_idx = -1;
+        *pExisting = false;
+        for (int idx=0; idx<NUM_SUPPORTED_PARAM_NOTIFY; idx++ ) {
+            if (!sCr_param_notify_list[idx].enabled) {
+                if (free_idx < 0)
+                    free_idx = idx;
+                continue;
+            }
+            if (pid == sCr_param_notify_list[idx].parameter_id) {
+                *pExisting = true;
+                return idx;
+            }
+        }
+        return free_idx;
+    }
+
     int pvtCrParam_config_param_notify(const cr_ParameterNotifyConfig *pnc,
                                        cr_ParameterNotifyConfigResponse *pncr)
     {
@@ -593,6 +1479,11 @@
             return cr_ErrorCodes_NO_ERROR;
         }
 
+        if (refuse_while_read_is_parked()) {
+            pncr->result = cr_ErrorCodes_INVALID_STATE;
+            return cr_ErrorCodes_INVALID_STATE;
+        }
+
         // reject enable on non-existing PID's.
         int rval = crcb_parameter_discover_reset(pnc->parameter_id);
         if (rval != cr_ErrorCodes_NO_ERROR) {
@@ -602,50 +1493,270 @@
             return cr_ErrorCodes_INVALID_PARAMETER;
         }
 
-        // see if an active notification already exists
-        for (idx=0; idx<NUM_SUPPORTED_PARAM_NOTIFY; idx++ ) {
-            if (!sCr_param_notify_list[idx].enabled)
+        bool existing;
+        idx = notify_find_slot(pnc->parameter_id, &existing);
+        if (idx < 0) {
+            // All notifications are in use.  
+            pncr->result = cr_ErrorCodes_NO_RESOURCE;
+            cr_report_error(cr_ErrorCodes_NO_RESOURCE, "No notificaiton slot available for PID %d.", pnc->parameter_id);
+            return cr_ErrorCodes_NO_RESOURCE;
+        }
+        sCr_param_notify_list[idx] = *pnc;
+        memset(&sCr_notify_triggers[idx], 0, sizeof(notify_trigger_t));
+        // store the index of the param with this PID.
+        i3_log(LOG_MASK_PARAMS, "%s notification %d on PID %d", 
+               existing ? "Updated" : "Enabled", idx, pnc->parameter_id);
+        pncr->result = cr_ErrorCodes_NO_ERROR;
+        return cr_ErrorCodes_NO_ERROR;
+    }
+
+    /**
+    * @brief   pvtCrParam_config_param_notify_list
+    * @details Applies one notification configuration to the parameters 
+    *          selected by ID, range and group, as for discovery.  The 
+    *          parameter table is walked once to find them.  If a listed ID 
+    *          does not exist or there are not enough free notifications, 
+    *          nothing is changed.
+    * @param   pncl decoded request.
+    * @param   pncr The response counts the parameters configured.
+    * @return  cr_ErrorCodes_NO_ERROR or an error like cr_ErrorCodes_NO_RESOURCE.
+    */
+    int pvtCrParam_config_param_notify_list(const cr_ParameterNotifyConfigList *pncl,
+                                            cr_ParameterNotifyConfigResponse *pncr)
+    {
+        uint32_t pids[NUM_SUPPORTED_PARAM_NOTIFY];
+        int num_pids = 0;
+        int rval = cr_ErrorCodes_NO_ERROR;
+
+        pncr->num_configured = 0;
+        if (refuse_while_read_is_parked()) {
+            pncr->result = cr_ErrorCodes_INVALID_STATE;
+            return cr_ErrorCodes_INVALID_STATE;
+        }
+        for (int i=0; i<pncl->parameter_ids_count; i++) {
+            if (pncl->parameter_ids[i] >= MAX_NUM_PARAM_ID) {
+                cr_report_error(cr_ErrorCodes_INVALID_PARAMETER, "Notification: PID %d not found.", 
+                                pncl->parameter_ids[i]);
+                pncr->result = cr_ErrorCodes_INVALID_PARAMETER;
+                return cr_ErrorCodes_INVALID_PARAMETER;
+            }
+        }
+
+        // One pass over the parameters.  Disabling needs no slots.
+        select_capture(pncl->parameter_ids, pncl->parameter_ids_count,
+                       pncl->ranges, pncl->ranges_count, pncl->group_name);
+        crcb_parameter_discover_reset(0);
+        const cr_ParameterInfo *pDesc;
+        while ((pDesc = select_next(DESC_SCRATCH)) != NULL)
+        {
+            if (!pncl->settings.enabled)
+            {
+                for (int idx=0; idx<NUM_SUPPORTED_PARAM_NOTIFY; idx++) {
+                    if (sCr_param_notify_list[idx].enabled &&
+                        (sCr_param_notify_list[idx].parameter_id == pDesc->id))
+                    {
+                        sCr_param_notify_list[idx].enabled = false;
+                        pncr->num_configured++;
+                    }
+                }
                 continue;
-            if (pnc->parameter_id == sCr_param_notify_list[idx].parameter_id) {
-                sCr_param_notify_list[idx] = *pnc;
-                // store the index of the param with this PID.
-                i3_log(LOG_MASK_PARAMS, "Updated notification %d on PID %d", idx, pnc->parameter_id);
-                pncr->result = cr_ErrorCodes_NO_ERROR;
-                return cr_ErrorCodes_NO_ERROR;
+            }
+            if (num_pids >= NUM_SUPPORTED_PARAM_NOTIFY) {
+                rval = cr_ErrorCodes_NO_RESOURCE;
+                break;
+            }
+            pids[num_pids++] = pDesc->id;
+        }
+        if (!pncl->settings.enabled)
+        {
+            i3_log(LOG_MASK_PARAMS, "Disabled %d notifications by list.", pncr->num_configured);
+            pncr->result = cr_ErrorCodes_NO_ERROR;
+            return cr_ErrorCodes_NO_ERROR;
+        }
+
+        // Every listed ID must exist.
+        for (int i=0; (rval == 0) && (i<pncl->parameter_ids_count); i++) {
+            int j;
+            for (j=0; j<num_pids; j++) {
+                if (pids[j] == pncl->parameter_ids[i])
+                    break;
+            }
+            if (j == num_pids) {
+                cr_report_error(cr_ErrorCodes_INVALID_PARAMETER, "Notification: PID %d not found.", 
+                                pncl->parameter_ids[i]);
+                pncr->result = cr_ErrorCodes_INVALID_PARAMETER;
+                return cr_ErrorCodes_INVALID_PARAMETER;
             }
         }
 
-        // Find an open entry
-        for (idx=0; idx<NUM_SUPPORTED_PARAM_NOTIFY; idx++ ) {
+        // There must be a slot for each before any is changed.
+        int num_free = 0, num_new = 0;
+        for (int idx=0; idx<NUM_SUPPORTED_PARAM_NOTIFY; idx++) {
             if (!sCr_param_notify_list[idx].enabled)
-                break;
+                num_free++;
         }
-        if (idx >= NUM_SUPPORTED_PARAM_NOTIFY) {
-            // All notifications are in use.  
+        for (int i=0; i<num_pids; i++) {
+            bool existing;
+            notify_find_slot(pids[i], &existing);
+            if (!existing)
+                num_new++;
+        }
+        if ((rval != 0) || (num_new > num_free)) {
             pncr->result = cr_ErrorCodes_NO_RESOURCE;
-            cr_report_error(cr_ErrorCodes_NO_RESOURCE, "No notificaiton slot available for PID %d.", pnc->parameter_id);
+            cr_report_error(cr_ErrorCodes_NO_RESOURCE, "Not enough notification slots for the list.");
             return cr_ErrorCodes_NO_RESOURCE;
         }
-        sCr_param_notify_list[idx] = *pnc;
-        // store the index of the param with this PID.
-        i3_log(LOG_MASK_PARAMS, "Enabled notification %d on PID %d", idx, pnc->parameter_id);
+
+        for (int i=0; i<num_pids; i++) {
+            bool existing;
+            int idx = notify_find_slot(pids[i], &existing);
+            sCr_param_notify_list[idx] = pncl->settings;
+            sCr_param_notify_list[idx].parameter_id = pids[i];
+            memset(&sCr_notify_triggers[idx], 0, sizeof(notify_trigger_t));
+        }
+        i3_log(LOG_MASK_PARAMS, "Enabled %d notifications by list.", num_pids);
+        pncr->num_configured = num_pids;
         pncr->result = cr_ErrorCodes_NO_ERROR;
         return cr_ErrorCodes_NO_ERROR;
     }
+
+    // Gets a numeric value for the trigger tests.
+    static double notify_value(const cr_ParameterValue *val)
+    {
+        switch (val->which_value) {
+        case cr_ParameterValue_uint32_value_tag:    return val->value.uint32_value;
+        case cr_ParameterValue_sint32_value_tag:    return val->value.sint32_value;
+        case cr_ParameterValue_float32_value_tag:   return val->value.float32_value;
+        case cr_ParameterValue_uint64_value_tag:    return (double)val->value.uint64_value;
+        case cr_ParameterValue_sint64_value_tag:    return (double)val->value.sint64_value;
+        case cr_ParameterValue_float64_value_tag:   return val->value.float64_value;
+        case cr_ParameterValue_bool_value_tag:      return val->value.bool_value;
+        case cr_ParameterValue_enum_value_tag:      return val->value.enum_value;
+        case cr_ParameterValue_bitfield_value_tag:  return val->value.bitfield_value;
+        default:                                    return 0;
+        }
+    }
+
+    // Tests a numeric change against the triggers of a notification.
+    // With a setpoint only a crossing is reported, and the value must leave
+    // the hysteresis band around the setpoint to cross.  Otherwise a change
+    // of minimum_delta is reported, plus the hysteresis when it reverses the
+    // last reported change, or a change faster than minimum_rate.
+    // direction receives the direction of the change.
+    static bool check_triggers(int idx, const cr_ParameterValue *curVal, 
+                               float delta, int8_t *direction)
+    {
+        const cr_ParameterNotifyConfig *pCfg = &sCr_param_notify_list[idx];
+        notify_trigger_t *pTrig = &sCr_notify_triggers[idx];
+        double cur  = notify_value(curVal);
+        double last = notify_value(&sCr_last_param_values[idx]);
+
+        if (pCfg->has_setpoint)
+        {
+            int8_t side = pTrig->side;
+            if (cur > (pCfg->setpoint + pCfg->hysteresis))
+                side = 1;
+            else if (cur < (pCfg->setpoint - pCfg->hysteresis))
+                side = -1;
+            if (side == pTrig->side)
+                return false;
+            pTrig->side = side;
+            i3_log(LOG_MASK_PARAMS, TEXT_MAGENTA "Notify PID %d on crossing %s setpoint" TEXT_RESET,
+                   pCfg->parameter_id, (side > 0) ? "above" : "below");
+            return true;
+        }
+
+        *direction = (cur > last) ? 1 : ((cur < last) ? -1 : 0);
+        float required = pCfg->minimum_delta;
+        if ((*direction != 0) && (*direction == -pTrig->direction))
+            required += pCfg->hysteresis;
+        bool notify = (delta >= required);
+        if (notify)
+        {
+            i3_log(LOG_MASK_PARAMS, TEXT_MAGENTA "Notify PID %d on delta %.1f" TEXT_RESET,
+                   pCfg->parameter_id, delta);
+        }
+
+        // The rate is measured between samples at least a window apart.
+        if (pCfg->minimum_rate == 0)
+            return notify;
+        uint32_t now = cr_get_current_ticks();
+        if (!pTrig->has_sample)
+        {
+            pTrig->has_sample = true;
+            pTrig->sample = cur;
+            pTrig->sample_ticks = now;
+            return notify;
+        }
+        uint32_t elapsed = now - pTrig->sample_ticks;
+        if (elapsed < NOTIFY_RATE_WINDOW)
+            return notify;
+        float rate = (fabs(cur - pTrig->sample) * SYS_TICK_RATE) / elapsed;
+        pTrig->sample = cur;
+        pTrig->sample_ticks = now;
+        if (!notify && (rate >= pCfg->minimum_rate))
+        {
+            i3_log(LOG_MASK_PARAMS, TEXT_MAGENTA "Notify PID %d on rate %.1f" TEXT_RESET,
+                   pCfg->parameter_id, rate);
+            notify = true;
+        }
+        return notify;
+    }
   #endif // NUM_SUPPORTED_PARAM_NOTIFY != 0
 
 #endif // def INCLUDE_PARAMETER_SERVICE
 
 /// <summary>
-/// clears any stale notifications. 
+/// drops any held read response, as its client has gone.
 /// To be called on connection to client 
 /// Must be available (empty) in all no-param case. 
 /// </summary>
+void pvtCrParam_drop_parked_read(void)
+{
+#if (defined(INCLUDE_PARAMETER_SERVICE) && defined(INCLUDE_PENDING_PARAM_READS) )
+    sCr_read_is_parked = false;
+    sCr_pending_read_mask = 0;
+  #endif
+}
+
+/// <summary>
+/// abandons a large parameter write, as its client has gone.
+/// To be called on connection to client 
+/// Must be available (empty) in all no-param case. 
+/// </summary>
+void pvtCrParam_drop_large_write(void)
+{
+#if (defined(INCLUDE_PARAMETER_SERVICE) && defined(INCLUDE_LARGE_PARAMETERS) )
+    sCr_large_write_active = false;
+  #endif
+}
+
+/// <summary>
+/// clears any stale notifications and any held read response. 
+/// To be called on connection to client unless the session is resumed.
+/// Must be available (empty) in all no-param case. 
+/// </summary>
 void pvtCrParam_clear_notifications(void)
 {
 #if (defined(INCLUDE_PARAMETER_SERVICE) && (NUM_SUPPORTED_PARAM_NOTIFY != 0) )
     memset(sCr_param_notify_list, 0, sizeof(sCr_param_notify_list));
     memset(sCr_last_param_values, 0, sizeof(sCr_last_param_values));
+    memset(sCr_notify_triggers, 0, sizeof(sCr_notify_triggers));
+  #endif
+    pvtCrParam_drop_parked_read();
+}
+
+/// <summary>
+/// Applies any writes without response that are waiting.  
+/// Called in cr_process() when idle, and before anything that must see them.
+/// Must be available (empty) in all no-param case. 
+/// </summary>
+void pvtCrParam_apply_pending_writes(void)
+{
+  #if (defined(INCLUDE_PARAMETER_SERVICE) && (NUM_PENDING_PARAM_WRITES != 0) )
+    for (int i=0; i<sCr_num_pending_writes; i++)
+        apply_write_without_response(&sCr_pending_writes[i]);
+    sCr_num_pending_writes = 0;
   #endif
 }
 
@@ -677,7 +1788,15 @@ void pvtCrParam_check_for_notifications()
             (timeSinceLastNotify > sCr_param_notify_list[idx].maximum_notification_period))
             needToNotify = true;
 
-        crcb_parameter_read(sCr_param_notify_list[idx].parameter_id, &curVal);
+        // A value still pending is checked next time.
+        int rv = param_read(sCr_param_notify_list[idx].parameter_id, &curVal);
+        if (rv != cr_ErrorCodes_NO_ERROR)
+        {
+            if (rv != cr_ErrorCodes_PENDING)
+                I3_LOG(LOG_MASK_PARAMS, "Notify: PID %d not read (%d).", 
+                       sCr_param_notify_list[idx].parameter_id, rv);
+            continue;
+        }
         switch (curVal.which_value) {
         // To match the apps and protobufs, must use _value_tags!
         case cr_ParameterValue_uint32_value_tag:
@@ -737,12 +1856,9 @@ void pvtCrParam_check_for_notifications()
             checkedDelta = false;
             break;
         }
-        if (checkedDelta && (delta >= sCr_param_notify_list[idx].minimum_delta))
-        {
-            i3_log(LOG_MASK_PARAMS, TEXT_MAGENTA "Notify PID %d on delta %.1f" TEXT_RESET,
-                   sCr_param_notify_list[idx].parameter_id, delta);
+        int8_t direction = 0;
+        if (checkedDelta && check_triggers(idx, &curVal, delta, &direction))
             needToNotify = true;
-        }
 
         if (curVal.which_value == cr_ParameterValue_string_value_tag) {
             if (strncmp(curVal.value.string_value, sCr_last_param_values[idx].value.string_value, REACH_PVAL_STRING_LEN))
@@ -766,6 +1882,8 @@ void pvtCrParam_check_for_notifications()
         if (needToNotify)
         {
             crcb_notify_param(&curVal);
+            if (direction != 0)
+                sCr_notify_triggers[idx].direction = direction;
 
             // save it for next time
             sCr_last_param_values[idx] = curVal;
@@ -776,3 +1894,166 @@ void pvtCrParam_check_for_notifications()
 }
 
 
+
+/**
+* @brief   cr_parameter_read_complete
+* @details Supplies a value for which crcb_parameter_read() returned 
+*          cr_ErrorCodes_PENDING.  The held read response is sent by 
+*          cr_process() once all of its values have been supplied.  A held
+*          derived value that waits on this parameter is computed from the 
+*          value given.
+* @note    Call this from the same context as cr_process().
+* @param   pid The parameter ID that was pending.
+* @param   value The value read.
+* @return  cr_ErrorCodes_NO_ERROR on success or cr_ErrorCodes_INVALID_PARAMETER
+*          if no held read was waiting for this parameter.
+*/
+int cr_parameter_read_complete(const uint32_t pid, const cr_ParameterValue *value)
+{
+  #if (defined(INCLUDE_PARAMETER_SERVICE) && defined(INCLUDE_PENDING_PARAM_READS) )
+    if (sCr_read_is_parked)
+    {
+        int rval = cr_ErrorCodes_INVALID_PARAMETER;
+      #if NUM_DERIVED_PARAMS != 0
+        // A derived value waiting on this input computes from the value 
+        // given rather than reading the app again.
+        sCr_supplied_value = value;
+        sCr_supplied_pid = pid;
+      #endif  // NUM_DERIVED_PARAMS != 0
+        for (int i=0; i<sCr_parked_read.values_count; i++)
+        {
+            if (!(sCr_pending_read_mask & (1u << i)))
+                continue;
+            if (sCr_parked_read.values[i].parameter_id == pid)
+            {
+                sCr_parked_read.values[i] = *value;
+                sCr_parked_read.values[i].parameter_id = pid;
+                sCr_pending_read_mask &= ~(1u << i);
+                I3_LOG(LOG_MASK_PARAMS, "Pending read of PID %d complete.", pid);
+                rval = cr_ErrorCodes_NO_ERROR;
+            }
+          #if NUM_DERIVED_PARAMS != 0
+            else if (derived_index(sCr_parked_read.values[i].parameter_id) >= 0)
+            {
+                // A derived value waiting for an input may be ready now.
+                if (param_read(sCr_parked_read.values[i].parameter_id, 
+                               &sCr_parked_read.values[i]) == cr_ErrorCodes_NO_ERROR)
+                {
+                    sCr_pending_read_mask &= ~(1u << i);
+                    rval = cr_ErrorCodes_NO_ERROR;
+                }
+            }
+          #endif  // NUM_DERIVED_PARAMS != 0
+        }
+      #if NUM_DERIVED_PARAMS != 0
+        sCr_supplied_value = NULL;
+      #endif  // NUM_DERIVED_PARAMS != 0
+        if (rval == cr_ErrorCodes_NO_ERROR)
+            return rval;
+    }
+    I3_LOG(LOG_MASK_PARAMS, "No pending read of PID %d.", pid);
+    return cr_ErrorCodes_INVALID_PARAMETER;
+  #else
+    (void)pid;
+    (void)value;
+    return cr_ErrorCodes_NOT_IMPLEMENTED;
+  #endif
+}
+
+/**
+* @brief   cr_parameter_changed
+* @details Notes a parameter changed by the app in the change journal so that
+*          a reconnecting client reads it.  Derived parameters computed from 
+*          it are recomputed when next read.  Writes from the client are noted
+*          by the stack.
+* @param   pid The parameter ID that changed.
+*/
+void cr_parameter_changed(const uint32_t pid)
+{
+  #ifdef INCLUDE_PARAMETER_SERVICE
+    param_changed(pid);
+  #else
+    (void)pid;
+  #endif
+}
+
+/**
+* @brief   cr_parameter_journal_restart
+* @details Empties the change journal and continues from the given sequence 
+*          number, or from just past the current one if that is later.  A 
+*          sequence that a client kept from before falls outside the journal,
+*          so its next read by sequence returns all parameters.  Call at 
+*          startup with a number that differs on each boot, such as a boot 
+*          count kept in NVM shifted into the upper bits.  Call with zero when
+*          all values have changed, as after a factory reset.
+* @param   sequence The next sequence number, or zero.
+*/
+void cr_parameter_journal_restart(const uint32_t sequence)
+{
+  #if defined(INCLUDE_PARAMETER_SERVICE) && (PARAM_JOURNAL_SIZE != 0)
+    journal_restart(sequence);
+  #else
+    (void)sequence;
+  #endif
+}
+
+/**
+* @brief   cr_parameter_read
+* @details Reads a parameter as a client would see it.  A derived parameter is
+*          computed from its inputs, or taken from the cache if none of them 
+*          has changed.  Others are read with crcb_parameter_read().
+* @param   pid The parameter ID to read.
+* @param   value Receives the value.
+* @return  cr_ErrorCodes_NO_ERROR or an error.
+*/
+int cr_parameter_read(const uint32_t pid, cr_ParameterValue *value)
+{
+  #ifdef INCLUDE_PARAMETER_SERVICE
+    return param_read(pid, value);
+  #else
+    return crcb_parameter_read(pid, value);
+  #endif
+}
+
+#if NUM_DERIVED_PARAMS != 0
+/**
+* @brief   cr_set_derived_parameters
+* @details Gives the stack the app's derived parameters.  Each is computed 
+*          only when read, by the client, a notification or 
+*          cr_parameter_read(), and cached until one of its inputs changes.
+*          An input changed by the app must be reported with 
+*          cr_parameter_changed().  Setting the table again, as after a 
+*          factory reset, drops all cached values.
+* @param   table The derived parameters.  It must remain valid.
+* @param   count The number in the table.
+* @return  cr_ErrorCodes_NO_ERROR or an error.
+*/
+int cr_set_derived_parameters(const cr_DerivedParameter *table, int count)
+{
+  #ifdef INCLUDE_PARAMETER_SERVICE
+    if (count > NUM_DERIVED_PARAMS)
+    {
+        LOG_ERROR("%d derived parameters exceed NUM_DERIVED_PARAMS (%d).", 
+                  count, NUM_DERIVED_PARAMS);
+        return cr_ErrorCodes_NO_RESOURCE;
+    }
+    for (int i=0; i<count; i++)
+    {
+        if ((table[i].num_inputs > CR_DERIVED_PARAM_MAX_INPUTS) || (table[i].compute == NULL))
+        {
+            LOG_ERROR("Derived PID %d is invalid.", table[i].pid);
+            return cr_ErrorCodes_INVALID_PARAMETER;
+        }
+    }
+    sCr_derived = table;
+    sCr_num_derived = count;
+    memset(sCr_derived_valid, 0, sizeof(sCr_derived_valid));
+    memset(sCr_derived_busy, 0, sizeof(sCr_derived_busy));
+    return cr_ErrorCodes_NO_ERROR;
+  #else
+    (void)table;
+    (void)count;
+    return cr_ErrorCodes_NOT_IMPLEMENTED;
+  #endif
+}
+#endif  // NUM_DERIVED_PARAMS != 0
@@ -84,10 +84,20 @@ extern "C" {
                              cr_FileTransferDataNotification *response);
     int pvtCrFile_transfer_data_notification(const cr_FileTransferDataNotification *request,
                                              cr_FileTransferData *dataTransfer);
+    // Reads ahead during a file read when the stack is idle.
+    void pvtCrFile_read_ahead(void);
+    // True if a file read has packets left to send in its window.
+    bool pvtCrFile_read_pending(void);
+    // File reads wait for the client to ACK again, as on a new connection.
+    void pvtCrFile_hold_reads(void);
+  #ifdef INCLUDE_FILE_MAPPED_READS
+    // Gives the mapped data of the file read packet to be encoded, once.
+    bool pvtCrFile_take_mapped_data(const uint8_t **ppData, size_t *size);
+  #endif
 
     /// <summary>
-    /// The file service includes a timeout Watchdog. 
-    /// 0 ms disables watchdog. 
+    /// The file service includes a timeout Watchdog for each transfer. 
+    /// These act on the current transfer.  0 ms disables watchdog. 
     /// </summary> 
     void pvtCr_watchdog_start_timeout(uint32_t msec, uint32_t ticks);
 
@@ -97,31 +107,65 @@ extern "C" {
     // disables the watchdog
     void pvtCr_watchdog_end_timeout();
 
-    // if active, compares ticks to expected timeout.
-    // return 1 if timeout occurred
+    // compares ticks to the timeout of each active watchdog.
+    // return 1 if a timeout occurred, making that transfer current.
     int pvtCr_watchdog_check_timeout(uint32_t ticks);
 
+    /// <summary>
+    /// Continues a CRC32 over data, starting from zero.  See cr_crc32.c.
+    /// </summary> 
+    uint32_t pvtCr_crc32(uint32_t crc, const uint8_t *data, size_t len);
+
+  #ifdef INCLUDE_FILE_COMPRESSION
+    /// <summary>
+    /// LZSS compression of file reads.  See cr_lzss.c.
+    /// The read function supplies up to max bytes, zero at the end.
+    /// </summary> 
+    typedef size_t (*cr_lzss_read_fn)(uint8_t *buf, size_t max);
+    void   pvtCr_lzss_start(cr_lzss_read_fn read);
+    void   pvtCr_lzss_restart(void);
+    size_t pvtCr_lzss_encode(uint8_t *out, size_t max);
+    bool   pvtCr_lzss_done(void);
+  #endif  // def INCLUDE_FILE_COMPRESSION
+
     ///  
     /// pvtCrParam_ functions support the (optional) parameters 
     /// service. 
     ///  
     void pvtCrParam_clear_notifications(void);
+    void pvtCrParam_drop_parked_read(void);
+    void pvtCrParam_drop_large_write(void);
 
     int pvtCrParam_discover_parameters(const cr_ParameterInfoRequest *,
                                        cr_ParameterInfoResponse *);
+    bool pvtCrParam_encode_param_info_response(pb_ostream_t *,
+                                               const cr_ParameterInfoResponse *);
     int pvtCrParam_discover_parameters_ex(const cr_ParameterInfoRequest *,
                                           cr_ParamExInfoResponse *);
     int pvtCrParam_read_param(const cr_ParameterRead *, 
                               cr_ParameterReadResult *);
+  #ifdef INCLUDE_PENDING_PARAM_READS
+    int pvtCrParam_resume_read(cr_ParameterReadResult *);
+  #endif // def INCLUDE_PENDING_PARAM_READS
     int pvtCrParam_write_param(const cr_ParameterWrite *, 
                                cr_ParameterWriteResult *);
+  #ifdef INCLUDE_LARGE_PARAMETERS
+    int pvtCrParam_read_large_param(const cr_LargeParameterRead *,
+                                    cr_LargeParameterData *);
+    int pvtCrParam_write_large_param(const cr_LargeParameterWrite *,
+                                     cr_LargeParameterWriteResult *);
+  #endif // def INCLUDE_LARGE_PARAMETERS
   #if NUM_SUPPORTED_PARAM_NOTIFY != 0
     int pvtCrParam_config_param_notify(const cr_ParameterNotifyConfig *,
                                        cr_ParameterNotifyConfigResponse *);
+    int pvtCrParam_config_param_notify_list(const cr_ParameterNotifyConfigList *,
+                                            cr_ParameterNotifyConfigResponse *);
   #endif // NUM_SUPPORTED_PARAM_NOTIFY != 0
     
     void pvtCrParam_check_for_notifications(void);
 
+    void pvtCrParam_apply_pending_writes(void);
+
 
 #ifdef __cplusplus
 }
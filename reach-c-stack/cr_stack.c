@@ -100,6 +100,13 @@ static cr_ReachMessage sCr_uncoded_message_structure;
 // static uint8_t sCr_decoded_prompt_buffer[UNCODED_PAYLOAD_SIZE] ALIGN_TO_WORD;
 static uint8_t *sCr_decoded_prompt_buffer = sCr_encoded_message_buffer;
 
+// The largest prompts must decode within that buffer.
+PB_STATIC_ASSERT(sizeof(cr_ParameterRead) <= CR_CODED_BUFFER_SIZE, PARAMETER_READ_EXCEEDS_PROMPT_BUFFER)
+PB_STATIC_ASSERT(sizeof(cr_ParameterInfoRequest) <= CR_CODED_BUFFER_SIZE, PARAMETER_INFO_REQUEST_EXCEEDS_PROMPT_BUFFER)
+PB_STATIC_ASSERT(sizeof(cr_ParameterWrite) <= CR_CODED_BUFFER_SIZE, PARAMETER_WRITE_EXCEEDS_PROMPT_BUFFER)
+PB_STATIC_ASSERT(sizeof(cr_FileTransferDataNotification) <= CR_CODED_BUFFER_SIZE, FILE_DATA_EXCEEDS_PROMPT_BUFFER)
+PB_STATIC_ASSERT(sizeof(cr_FileTransferData) <= UNCODED_PAYLOAD_SIZE, FILE_TRANSFER_DATA_EXCEEDS_PAYLOAD_BUFFER)
+
 // An uncoded response payload.
 static uint8_t sCr_uncoded_response_buffer[UNCODED_PAYLOAD_SIZE] ALIGN_TO_WORD;
 
@@ -125,6 +132,22 @@ uint32_t pvtCr_num_remaining_objects = 0;
 // static (private) "member" variables
 //----------------------------------------------------------------------------
 static int sCr_transaction_id = 0;
+#ifdef INCLUDE_PENDING_PARAM_READS
+// The transaction of a read response held for pending values.
+static int sCr_parked_transaction_id = 0;
+#endif  // def INCLUDE_PENDING_PARAM_READS
+#ifdef INCLUDE_FILE_SERVICE
+// Set after a packet of a file read, so that a waiting prompt goes next.
+static bool sCr_file_prompt_turn = false;
+#endif  // def INCLUDE_FILE_SERVICE
+#ifdef INCLUDE_SESSION_RESUME
+// Given to the client in device info, to be presented on reconnection.
+static uint32_t sCr_session_token = 0;
+static uint32_t sCr_disconnect_ticks = 0;
+// From connection until the client resumes or not, the notifications of the
+// previous session are held but not sent.
+static bool sCr_session_undecided = false;
+#endif  // def INCLUDE_SESSION_RESUME
 static bool sCR_error_reported = false;
 
 //----------------------------------------------------------------------------
@@ -219,6 +242,13 @@ static int handle_continued_transactions()
 {
     int rval = 0;
 
+  #ifdef INCLUDE_FILE_SERVICE
+    // Another file read may have packets left to send in its window.
+    if ((pvtCr_continued_message_type == cr_ReachMessageTypes_INVALID) &&
+        pvtCrFile_read_pending())
+        pvtCr_continued_message_type = cr_ReachMessageTypes_TRANSFER_DATA;
+  #endif  // def INCLUDE_FILE_SERVICE
+
     if (pvtCr_continued_message_type == cr_ReachMessageTypes_INVALID)
     {
         // I3_LOG(LOG_MASK_REACH, "%s(): No continued transactions.", __FUNCTION__);
@@ -244,7 +274,20 @@ static int handle_continued_transactions()
     case cr_ReachMessageTypes_READ_PARAMETERS:
         I3_LOG(LOG_MASK_REACH, "%s(): Continued rp.", __FUNCTION__);
         rval = pvtCrParam_read_param(NULL, (cr_ParameterReadResult *)sCr_uncoded_response_buffer);
+      #ifdef INCLUDE_PENDING_PARAM_READS
+        if (rval == cr_ErrorCodes_PENDING)
+        {   // sent by handle_parked_read() when complete.
+            sCr_parked_transaction_id = sCr_transaction_id;
+            return cr_ErrorCodes_NO_DATA;
+        }
+      #endif  // def INCLUDE_PENDING_PARAM_READS
+        break;
+      #ifdef INCLUDE_LARGE_PARAMETERS
+    case cr_ReachMessageTypes_READ_LARGE_PARAM:
+        I3_LOG(LOG_MASK_REACH, "%s(): Continued rlp.", __FUNCTION__);
+        rval = pvtCrParam_read_large_param(NULL, (cr_LargeParameterData *)sCr_uncoded_response_buffer);
         break;
+      #endif  // def INCLUDE_LARGE_PARAMETERS
     #endif  // def INCLUDE_PARAMETER_SERVICE
 
     #ifdef INCLUDE_FILE_SERVICE
@@ -252,6 +295,7 @@ static int handle_continued_transactions()
         I3_LOG(LOG_MASK_REACH, "%s(): Continued rf.", __FUNCTION__);
         rval = pvtCrFile_transfer_data_notification(NULL, (cr_FileTransferData *)sCr_uncoded_response_buffer);
         encode_message_type = cr_ReachMessageTypes_TRANSFER_DATA;
+        sCr_file_prompt_turn = true;
         break;
     #endif // def INCLUDE_FILE_SERVICE
 
@@ -280,6 +324,36 @@ static int handle_continued_transactions()
     return rval;
 }
 
+// Sends a read response that was held for values supplied later by the app.
+// Returns cr_ErrorCodes_NO_DATA when there is nothing to send.
+static int handle_parked_read()
+{
+  #ifdef INCLUDE_PENDING_PARAM_READS
+    // A transaction started while the read was held is finished first.
+    if (pvtCr_continued_message_type != cr_ReachMessageTypes_INVALID)
+        return cr_ErrorCodes_NO_DATA;
+
+    int rval = pvtCrParam_resume_read((cr_ParameterReadResult *)sCr_uncoded_response_buffer);
+    if (rval != 0)
+        return rval;
+
+    cr_ReachMessageHeader msg_header;
+    memset(&msg_header, 0, sizeof(msg_header));
+    msg_header.message_type      = cr_ReachMessageTypes_READ_PARAMETERS;
+    msg_header.number_of_objects = pvtCr_num_continued_objects;
+    msg_header.remaining_objects = pvtCr_num_remaining_objects;
+    msg_header.transaction_id    = sCr_parked_transaction_id;
+    rval = cr_encode_message(cr_ReachMessageTypes_READ_PARAMETERS,
+                             sCr_uncoded_response_buffer,
+                             &msg_header);
+    if (pvtCr_num_remaining_objects == 0)
+        pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
+    return rval;
+  #else
+    return cr_ErrorCodes_NO_DATA;
+  #endif  // def INCLUDE_PENDING_PARAM_READS
+}
+
 static bool sCr_challenge_key_valid = true;
 static bool test_challenge_key_is_valid(uint32_t challenge_key)
 {
@@ -439,6 +513,7 @@ int cr_process(uint32_t ticks)
   #ifdef INCLUDE_FILE_SERVICE
     int timeout = pvtCr_watchdog_check_timeout(ticks);
     if (timeout) {
+        // Ends the watchdog of the transfer that timed out.
         i3_log(LOG_MASK_ERROR, "Timeout watchdog expired.");
         pvtCr_watchdog_end_timeout();
     }
@@ -477,16 +552,40 @@ int cr_process(uint32_t ticks)
     //   zero indicates valid data was produced.
     //   cr_ErrorCodes_NO_DATA indicates no data was produced.
     //   Other non-zero values indicate an error report was produced.
-    int rval = handle_continued_transactions();
+    int rval = handle_parked_read();
+    bool have_prompt = false;
+  #ifdef INCLUDE_FILE_SERVICE
+    // The packets of a file read window are a continued transaction.  
+    // A waiting prompt goes between them so that other transfers progress.
+    if ((rval == cr_ErrorCodes_NO_DATA) && sCr_file_prompt_turn)
+    {
+        sCr_file_prompt_turn = false;
+        have_prompt = (crcb_get_coded_prompt(sCr_encoded_message_buffer, 
+                                             &sCr_encoded_message_size) 
+                       != cr_ErrorCodes_NO_DATA);
+    }
+  #endif  // def INCLUDE_FILE_SERVICE
+    if ((rval == cr_ErrorCodes_NO_DATA) && !have_prompt)
+        rval = handle_continued_transactions();
     if (rval == cr_ErrorCodes_NO_DATA)
     {
         // Gets the encoded buffer from the app.
-        rval = crcb_get_coded_prompt(sCr_encoded_message_buffer, &sCr_encoded_message_size);
+        if (have_prompt)
+            rval = cr_ErrorCodes_NO_ERROR;
+        else
+            rval = crcb_get_coded_prompt(sCr_encoded_message_buffer, &sCr_encoded_message_size);
         if (rval == cr_ErrorCodes_NO_DATA)
         {
             sCr_encoded_message_size = 0;
 
-            // check notifications when nothing else is happening.
+            // apply writes and check notifications when nothing else is happening.
+            pvtCrParam_apply_pending_writes();
+          #ifdef INCLUDE_FILE_SERVICE
+            pvtCrFile_read_ahead();
+          #endif  // def INCLUDE_FILE_SERVICE
+          #ifdef INCLUDE_SESSION_RESUME
+            if (!sCr_session_undecided)
+          #endif  // def INCLUDE_SESSION_RESUME
             pvtCrParam_check_for_notifications();
 
             return cr_ErrorCodes_NO_DATA;
@@ -528,6 +627,33 @@ uint32_t cr_get_current_ticks()
     return sCurrentTicks;
 }
 
+#ifdef INCLUDE_SESSION_RESUME
+// Session tokens need only differ from one session to the next.  They 
+// are not a credential; the challenge key still guards the device.
+static uint32_t session_next_token(void)
+{
+    uint32_t x = sCr_session_token ^ (sCurrentTicks * 2654435761u) ^ (uint32_t)sCallCount;
+    if (x == 0)
+        x = 1;
+    // xorshift32
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// Starts the session of a newly connected client with a new token.  
+// Unless resumed, the notifications of the previous session are cleared.
+static void session_start(bool resume)
+{
+    if (!resume)
+        pvtCrParam_clear_notifications();
+    sCr_session_token = session_next_token();
+    sCr_session_undecided = false;
+    I3_LOG(LOG_MASK_REACH, "Session %s.", resume ? "resumed" : "started");
+}
+#endif  // def INCLUDE_SESSION_RESUME
+
 /**
 * @brief   cr_set_comm_link_connected
 * @details The communication stack must inform the Reach stack of the status of 
@@ -535,7 +661,8 @@ uint32_t cr_get_current_ticks()
 *          the connection status changes. The Reach loop only runs when the
 *          connection is valid. All parameter notifications are cleared when a
 *          connection is established. The client must reenable notifications on
-*          each connection.
+*          each connection, unless INCLUDE_SESSION_RESUME is defined and the 
+*          client resumes its session.
 * @param   connected true if connected.
 */
 static bool sCr_comm_link_is_connected = false;
@@ -547,7 +674,21 @@ void cr_set_comm_link_connected(bool connected)
        pvtCr_continued_message_type = cr_ReachMessageTypes_INVALID;
        pvtCr_num_continued_objects = 0; 
        pvtCr_num_remaining_objects = 0;
+     #ifdef INCLUDE_FILE_SERVICE
+       pvtCrFile_hold_reads();
+     #endif  // def INCLUDE_FILE_SERVICE
+       pvtCrParam_drop_large_write();
+     #ifdef INCLUDE_SESSION_RESUME
+       pvtCrParam_drop_parked_read();
+       // Hold the notifications until the client says whether it resumes.
+       if ((sCr_session_token != 0) &&
+           ((sCurrentTicks - sCr_disconnect_ticks) < SESSION_RESUME_TIMEOUT_MS))
+           sCr_session_undecided = true;
+       else
+           session_start(false);
+     #else
        pvtCrParam_clear_notifications();
+     #endif  // def INCLUDE_SESSION_RESUME
      #ifdef APP_REQUIRED_CHALLENGE_KEY
        sCr_challenge_key_valid = false;
      #endif 
@@ -555,6 +696,14 @@ void cr_set_comm_link_connected(bool connected)
        sCr_parameter_key_valid = false;
      #endif
    }
+   if (sCr_comm_link_is_connected && !connected)
+   {
+       // The client sent these before leaving.
+       pvtCrParam_apply_pending_writes();
+     #ifdef INCLUDE_SESSION_RESUME
+       sCr_disconnect_ticks = sCurrentTicks;
+     #endif  // def INCLUDE_SESSION_RESUME
+   }
    sCr_comm_link_is_connected = connected;
 } 
 
@@ -710,6 +859,11 @@ void cr_test_sizes()
     rval += checkSize(cr_ParameterNotification_size, MAX_BLE_SZ, "cr_ParameterNotification_size");
     rval += checkSize(cr_ParameterNotifyConfigResponse_size, MAX_BLE_SZ, "cr_ParameterNotifyConfigResponse_size");
     rval += checkSize(cr_ParameterNotifyConfig_size, MAX_BLE_SZ, "cr_ParameterNotifyConfig_size");
+    rval += checkSize(cr_ParameterNotifyConfigList_size, MAX_BLE_SZ, "cr_ParameterNotifyConfigList_size");
+    rval += checkSize(cr_LargeParameterRead_size, MAX_BLE_SZ, "cr_LargeParameterRead_size");
+    rval += checkSize(cr_LargeParameterData_size, MAX_BLE_SZ, "cr_LargeParameterData_size");
+    rval += checkSize(cr_LargeParameterWrite_size, MAX_BLE_SZ, "cr_LargeParameterWrite_size");
+    rval += checkSize(cr_LargeParameterWriteResult_size, MAX_BLE_SZ, "cr_LargeParameterWriteResult_size");
     rval += checkSize(cr_ParameterReadResult_size, MAX_BLE_SZ, "cr_ParameterReadResult_size");
     rval += checkSize(cr_ParameterRead_size, MAX_BLE_SZ, "cr_ParameterRead_size");
     rval += checkSize(cr_ParameterValue_size, MAX_BLE_SZ, "cr_ParameterValue_size");
@@ -731,6 +885,9 @@ void cr_test_sizes()
     rval += checkSize(sizeof(cr_ParameterReadResult), MAX_RAW_SZ, "sizeof(cr_ParameterReadResult)");
     rval += checkSize(sizeof(cr_ParameterWrite), MAX_RAW_SZ, "sizeof(cr_ParameterWrite)");
     rval += checkSize(sizeof(cr_ParameterNotifyConfig), MAX_RAW_SZ, "sizeof(cr_ParameterNotifyConfig)");
+    rval += checkSize(sizeof(cr_ParameterNotifyConfigList), MAX_RAW_SZ, "sizeof(cr_ParameterNotifyConfigList)");
+    rval += checkSize(sizeof(cr_LargeParameterData), MAX_RAW_SZ, "sizeof(cr_LargeParameterData)");
+    rval += checkSize(sizeof(cr_LargeParameterWrite), MAX_RAW_SZ, "sizeof(cr_LargeParameterWrite)");
     rval += checkSize(sizeof(cr_ParameterNotification), MAX_RAW_SZ, "sizeof(cr_ParameterNotification)");
     rval += checkSize(sizeof(cr_ParameterNotifyConfigResponse), MAX_RAW_SZ, "sizeof(cr_ParameterNotifyConfigResponse)");
     rval += checkSize(sizeof(cr_ParameterValue), MAX_RAW_SZ, "sizeof(cr_ParameterValue)");
@@ -785,6 +942,12 @@ handle_message(const cr_ReachMessageHeader *hdr, const uint8_t *coded_data, size
     pvtCr_num_continued_objects = 0;  // default
     pvtCr_num_remaining_objects = 0;  // default
 
+  #ifdef INCLUDE_SESSION_RESUME
+    // A client that does not ask for device info first does not resume.
+    if (sCr_session_undecided && (message_type != cr_ReachMessageTypes_GET_DEVICE_INFO))
+        session_start(false);
+  #endif  // def INCLUDE_SESSION_RESUME
+
     int rval = 0;
     switch (message_type)
     {
@@ -811,6 +974,13 @@ handle_message(const cr_ReachMessageHeader *hdr, const uint8_t *coded_data, size
     case cr_ReachMessageTypes_READ_PARAMETERS:
         rval = pvtCrParam_read_param((cr_ParameterRead *)sCr_decoded_prompt_buffer,
                           (cr_ParameterReadResult *)sCr_uncoded_response_buffer);
+      #ifdef INCLUDE_PENDING_PARAM_READS
+        if (rval == cr_ErrorCodes_PENDING)
+        {   // sent by handle_parked_read() when complete.
+            sCr_parked_transaction_id = sCr_transaction_id;
+            rval = cr_ErrorCodes_NO_RESPONSE;
+        }
+      #endif  // def INCLUDE_PENDING_PARAM_READS
         break;
 
     case cr_ReachMessageTypes_WRITE_PARAMETERS:
@@ -818,11 +988,28 @@ handle_message(const cr_ReachMessageHeader *hdr, const uint8_t *coded_data, size
                            (cr_ParameterWriteResult *)sCr_uncoded_response_buffer);
         break;
 
+    #ifdef INCLUDE_LARGE_PARAMETERS
+    case cr_ReachMessageTypes_READ_LARGE_PARAM:
+        rval = pvtCrParam_read_large_param((cr_LargeParameterRead *)sCr_decoded_prompt_buffer,
+                           (cr_LargeParameterData *)sCr_uncoded_response_buffer);
+        break;
+
+    case cr_ReachMessageTypes_WRITE_LARGE_PARAM:
+        rval = pvtCrParam_write_large_param((cr_LargeParameterWrite *)sCr_decoded_prompt_buffer,
+                           (cr_LargeParameterWriteResult *)sCr_uncoded_response_buffer);
+        break;
+    #endif  // def INCLUDE_LARGE_PARAMETERS
+
     #if NUM_SUPPORTED_PARAM_NOTIFY != 0
     case cr_ReachMessageTypes_CONFIG_PARAM_NOTIFY:
         rval = pvtCrParam_config_param_notify((cr_ParameterNotifyConfig *)sCr_decoded_prompt_buffer,
                            (cr_ParameterNotifyConfigResponse *)sCr_uncoded_response_buffer);
         break;
+
+    case cr_ReachMessageTypes_CONFIG_PARAM_NOTIFY_LIST:
+        rval = pvtCrParam_config_param_notify_list((cr_ParameterNotifyConfigList *)sCr_decoded_prompt_buffer,
+                           (cr_ParameterNotifyConfigResponse *)sCr_uncoded_response_buffer);
+        break;
     #endif
   #endif // def INCLUDE_PARAMETER_SERVICE
 
@@ -1014,6 +1201,16 @@ handle_get_device_info(const cr_DeviceInfoRequest *request,  // in
     response->parameter_metadata_hash = crcb_compute_parameter_hash();
 #endif  // def INCLUDE_PARAMETER_SERVICE
 
+#ifdef INCLUDE_SESSION_RESUME
+    if (sCr_session_undecided)
+    {
+        response->session_resumed = request->has_session_token &&
+                                    (request->session_token == sCr_session_token);
+        session_start(response->session_resumed);
+    }
+    response->session_token = sCr_session_token;
+#endif  // def INCLUDE_SESSION_RESUME
+
     response->protocol_version = cr_ReachProtoVersion_CURRENT_VERSION;
     populate_device_info_sizes(response);
     return 0;
@@ -1197,12 +1394,15 @@ bool encode_reach_payload(cr_ReachMessageTypes message_type,    // in
 
 #ifdef INCLUDE_PARAMETER_SERVICE
   case cr_ReachMessageTypes_DISCOVER_PARAMETERS:
-      status = pb_encode(&os_stream, cr_ParameterInfoResponse_fields, data);
+      status = pvtCrParam_encode_param_info_response(&os_stream, 
+                                                     (cr_ParameterInfoResponse *)data);
       if (status) {
         *encode_size = os_stream.bytes_written;
+      #ifndef INCLUDE_PARAM_DESCRIPTION_PTR
         LOG_REACH("Discover parameter response: \n%s\n",
                   message_util_param_info_response_json(
                       (cr_ParameterInfoResponse *)data));
+      #endif  // ndef INCLUDE_PARAM_DESCRIPTION_PTR
       }
       break;
   case cr_ReachMessageTypes_DISCOVER_PARAM_EX:
@@ -1237,8 +1437,33 @@ bool encode_reach_payload(cr_ReachMessageTypes message_type,    // in
       }
       break;
 
+  #ifdef INCLUDE_LARGE_PARAMETERS
+  case cr_ReachMessageTypes_READ_LARGE_PARAM:
+      status = pb_encode(&os_stream, cr_LargeParameterData_fields, data);
+      if (status) {
+        *encode_size = os_stream.bytes_written;
+        LOG_REACH("Large parameter %d data: %d bytes at %d of %d\n",
+                  ((cr_LargeParameterData *)data)->parameter_id,
+                  ((cr_LargeParameterData *)data)->data.size,
+                  ((cr_LargeParameterData *)data)->offset,
+                  ((cr_LargeParameterData *)data)->total_size);
+      }
+      break;
+  case cr_ReachMessageTypes_WRITE_LARGE_PARAM:
+      status = pb_encode(&os_stream, cr_LargeParameterWriteResult_fields, data);
+      if (status) {
+        *encode_size = os_stream.bytes_written;
+        LOG_REACH("Large parameter %d write result %d, next offset %d\n",
+                  ((cr_LargeParameterWriteResult *)data)->parameter_id,
+                  ((cr_LargeParameterWriteResult *)data)->result,
+                  ((cr_LargeParameterWriteResult *)data)->offset);
+      }
+      break;
+  #endif  // def INCLUDE_LARGE_PARAMETERS
+
   #if NUM_SUPPORTED_PARAM_NOTIFY != 0
   case cr_ReachMessageTypes_CONFIG_PARAM_NOTIFY:
+  case cr_ReachMessageTypes_CONFIG_PARAM_NOTIFY_LIST:
       status = pb_encode(&os_stream, cr_ParameterNotifyConfigResponse_fields, data);
       if (status) {
         *encode_size = os_stream.bytes_written;
@@ -1403,6 +1628,44 @@ bool encode_reach_message(const cr_ReachMessage *message,   // in:  message to b
   return status;
 }
 
+#ifdef INCLUDE_FILE_MAPPED_READS
+// The data of a mapped file read is not in the cr_FileTransferData.  The 
+// envelope is written field by field so that the data is copied straight 
+// from the file into sCr_encoded_response_buffer, after the other fields 
+// already in sCr_encoded_payload_buffer.  Protobuf allows any field order.
+static int encode_mapped_transfer_data(const cr_ReachMessageHeader *hdr,
+                                       const uint8_t *data,
+                                       size_t size)
+{
+    pb_ostream_t data_stream = PB_OSTREAM_SIZING;
+    pb_encode_tag(&data_stream, PB_WT_STRING, cr_FileTransferData_message_data_tag);
+    pb_encode_varint(&data_stream, size);
+    size_t payload_size = sCr_encoded_payload_size + data_stream.bytes_written + size;
+
+    pb_ostream_t os_stream = pb_ostream_from_buffer(sCr_encoded_response_buffer,
+                                                    sizeof(sCr_encoded_response_buffer));
+    bool status = 
+        pb_encode_tag(&os_stream, PB_WT_STRING, cr_ReachMessage_header_tag) &&
+        pb_encode_submessage(&os_stream, cr_ReachMessageHeader_fields, hdr) &&
+        pb_encode_tag(&os_stream, PB_WT_STRING, cr_ReachMessage_payload_tag) &&
+        pb_encode_varint(&os_stream, payload_size) &&
+        pb_write(&os_stream, sCr_encoded_payload_buffer, sCr_encoded_payload_size) &&
+        pb_encode_tag(&os_stream, PB_WT_STRING, cr_FileTransferData_message_data_tag) &&
+        pb_encode_varint(&os_stream, size) &&
+        pb_write(&os_stream, data, size);
+    if (!status)
+    {
+        LOG_ERROR("Encoding failed: %s\n", PB_GET_ERROR(&os_stream));
+        cr_report_error(cr_ErrorCodes_ENCODING_FAILED, "encode mapped file data failed.");
+        return cr_ErrorCodes_ENCODING_FAILED;
+    }
+    sCr_encoded_response_size = os_stream.bytes_written;
+    LOG_DUMP_WIRE("The encoded message", sCr_encoded_response_buffer, 
+                  sCr_encoded_response_size);
+    return 0;
+}
+#endif  // def INCLUDE_FILE_MAPPED_READS
+
 // encodes message to sCr_encoded_response_buffer.
 // The caller must populate the header
 static int cr_encode_message(cr_ReachMessageTypes message_type,    // in
@@ -1424,6 +1687,15 @@ static int cr_encode_message(cr_ReachMessageTypes message_type,    // in
     // build the message envelope
     sCr_uncoded_message_structure.header     = *hdr;
     sCr_uncoded_message_structure.has_header = true;
+  #ifdef INCLUDE_FILE_MAPPED_READS
+    const uint8_t *mapped_data;
+    size_t mapped_size;
+    if ((message_type == cr_ReachMessageTypes_TRANSFER_DATA) &&
+        pvtCrFile_take_mapped_data(&mapped_data, &mapped_size))
+    {
+        return encode_mapped_transfer_data(hdr, mapped_data, mapped_size);
+    }
+  #endif  // def INCLUDE_FILE_MAPPED_READS
     memcpy(sCr_uncoded_message_structure.payload.bytes, 
            sCr_encoded_payload_buffer, 
            sCr_encoded_payload_size);
@@ -155,6 +155,44 @@ bool cr_get_comm_link_connected(void);
 
 uint32_t cr_get_current_ticks();
 
+// Supplies a value for which crcb_parameter_read() returned cr_ErrorCodes_PENDING.
+// Call this from the same context as cr_process().
+int cr_parameter_read_complete(const uint32_t pid, const cr_ParameterValue *value);
+
+// Notes a parameter changed by the app in the change journal.
+// Writes from the client are noted by the stack.
+void cr_parameter_changed(const uint32_t pid);
+
+// Empties the change journal so that earlier sequences read all parameters.
+// Call at startup with a number that differs on each boot, or with zero.
+void cr_parameter_journal_restart(const uint32_t sequence);
+
+// Reads a parameter as a client would see it, computing a derived value.
+int cr_parameter_read(const uint32_t pid, cr_ParameterValue *value);
+
+#if NUM_DERIVED_PARAMS != 0
+  /// The most inputs of one derived parameter.
+  #define CR_DERIVED_PARAM_MAX_INPUTS   4
+
+  /// Computes a derived parameter from the values of its inputs, in the 
+  /// order listed.  Returns zero or an error code.
+  typedef int (*cr_derive_fn)(const uint32_t pid, const cr_ParameterValue *inputs,
+                              cr_ParameterValue *result);
+
+  /// A parameter computed from others.  It is also described to the client 
+  /// like any other parameter, normally read only.
+  typedef struct {
+      uint32_t      pid;
+      uint32_t      input_pids[CR_DERIVED_PARAM_MAX_INPUTS];
+      uint8_t       num_inputs;
+      cr_derive_fn  compute;
+  } cr_DerivedParameter;
+
+  // Gives the stack the app's derived parameters.  They are computed when
+  // read and cached until an input changes.  The table must remain valid.
+  int cr_set_derived_parameters(const cr_DerivedParameter *table, int count);
+#endif  // NUM_DERIVED_PARAMS != 0
+
 void cr_test_sizes();
 
 
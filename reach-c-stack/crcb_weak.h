@@ -216,6 +216,28 @@ int crcb_ping_get_signal_strength(int8_t *rssi);
     */
     int crcb_parameter_discover_next(cr_ParameterInfo *pDesc);
 
+    /**
+    * @brief   crcb_parameter_get_description_ptr
+    * @details Used instead of crcb_parameter_discover_reset() and 
+    *          crcb_parameter_discover_next() when INCLUDE_PARAM_DESCRIPTION_PTR
+    *          is defined.  The stack encodes the description in place, which 
+    *          saves copying it.  Suits descriptions held in a const table.
+    * @param   pid The parameter ID.
+    * @return  A pointer to the description, which must remain valid, or NULL 
+    *          if the parameter ID is not valid.
+    */
+    const cr_ParameterInfo *crcb_parameter_get_description_ptr(const uint32_t pid);
+
+    /**
+    * @brief   crcb_parameter_discover_next_ptr
+    * @details The pointer form of crcb_parameter_discover_next(), used when 
+    *          INCLUDE_PARAM_DESCRIPTION_PTR is defined.  The iteration is 
+    *          restarted by crcb_parameter_discover_reset().
+    * @return  A pointer to the next description, which must remain valid, or 
+    *          NULL if the last parameter has already been returned.
+    */
+    const cr_ParameterInfo *crcb_parameter_discover_next_ptr(void);
+
     /**
     * @brief   crcb_parameter_ex_get_count
     * @details returns the number of parameter extension exposed by this device.
@@ -262,7 +284,9 @@ int crcb_ping_get_signal_strength(int8_t *rssi);
     * @return  cr_ErrorCodes_NO_ERROR on success or an error like  
     *          cr_ErrorCodes_INVALID_PARAMETER if the parameter ID is not valid.
     *          Also can return cr_ErrorCodes_READ_FAILED or
-    *          cr_ErrorCodes_PERMISSION_DENIED
+    *          cr_ErrorCodes_PERMISSION_DENIED.  With INCLUDE_PENDING_PARAM_READS
+    *          cr_ErrorCodes_PENDING indicates that the value will be supplied 
+    *          later using cr_parameter_read_complete().
     */
     int crcb_parameter_read(const uint32_t pid, cr_ParameterValue *data);
 
@@ -282,6 +306,42 @@ int crcb_ping_get_signal_strength(int8_t *rssi);
     */
     int crcb_parameter_write(const uint32_t pid, const cr_ParameterValue *data);
 
+  #ifdef INCLUDE_LARGE_PARAMETERS
+    /**
+    * @brief   crcb_parameter_read_large
+    * @details Reads part of a LARGE_BYTES parameter.  The stack reads the 
+    *          value a chunk at a time to respond to READ_LARGE_PARAM.
+    * @param   pid (input) parameter ID
+    * @param   offset (input) The first byte to be read.
+    * @param   data Pointer to stack provided memory into which the bytes must 
+    *               be copied.
+    * @param   len (input) The space at data.  (output) The bytes copied, fewer
+    *              at the end of the value.
+    * @param   total_size (output) The current size of the whole value.
+    * @return  cr_ErrorCodes_NO_ERROR on success or an error like  
+    *          cr_ErrorCodes_INVALID_PARAMETER if the parameter ID is not valid.
+    */
+    int crcb_parameter_read_large(const uint32_t pid, uint32_t offset, 
+                                  uint8_t *data, size_t *len, uint32_t *total_size);
+
+    /**
+    * @brief   crcb_parameter_write_large
+    * @details Writes one chunk of a LARGE_BYTES parameter.  The stack passes 
+    *          the chunks of WRITE_LARGE_PARAM in order, starting at offset 
+    *          zero.  The value is complete when offset + len == total_size.
+    * @param   pid (input) parameter ID
+    * @param   offset (input) Where the chunk goes.
+    * @param   data (input) The bytes of the chunk.
+    * @param   len (input) The number of bytes at data.
+    * @param   total_size (input) The size of the whole new value.
+    * @return  cr_ErrorCodes_NO_ERROR on success or an error like  
+    *          cr_ErrorCodes_INVALID_PARAMETER if the parameter ID is not valid.
+    *          cr_ErrorCodes_NO_RESOURCE if total_size is too large.
+    */
+    int crcb_parameter_write_large(const uint32_t pid, uint32_t offset, 
+                                   const uint8_t *data, size_t len, uint32_t total_size);
+  #endif  // def INCLUDE_LARGE_PARAMETERS
+
     /**
     * @brief   crcb_compute_parameter_hash
     * @details The overriding implementation is to compute a number that will change
@@ -293,6 +353,20 @@ int crcb_ping_get_signal_strength(int8_t *rssi);
     */
     uint32_t crcb_compute_parameter_hash(void);
 
+    /**
+    * @brief   crcb_parameter_is_in_group
+    * @details Named groups let a client select a set of parameters by name in
+    *          READ_PARAMETERS and DISCOVER_PARAMETERS.  The stack walks the 
+    *          parameter table and asks the application about each parameter.
+    *          The group names and their meaning are defined by the application.
+    * @param   group_name (input) The name given by the client.
+    * @param   pDesc (input) The description of the parameter in question.
+    * @return  true if the parameter is a member of the named group.  The weak 
+    *          implementation has no groups and returns false.
+    */
+    bool crcb_parameter_is_in_group(const char *group_name, 
+                                    const cr_ParameterInfo *pDesc);
+
   #if NUM_SUPPORTED_PARAM_NOTIFY >= 0
     /**
     * @brief   crcb_notify_param
@@ -430,10 +504,33 @@ int crcb_ping_get_signal_strength(int8_t *rssi);
                    uint8_t *pData,                // where the data goes
                    int *pBytes_read);             // bytes actually read, negative for errors.
 
+  #ifdef INCLUDE_FILE_MAPPED_READS
+    /**
+    * @brief   crcb_file_get_mapped_data
+    * @details For a file that lives in memory, such as internal flash or RAM.  
+    *          The stack then sends a file read straight from that memory 
+    *          instead of calling crcb_read_file().  Called when a read starts.
+    * @param   fid (input) which file
+    * @param   offset (input) where the read starts
+    * @param   bytes (input) the length of the read
+    * @param   ppData (output) points to the data at offset.  It must not 
+    *          change until the read ends.
+    * @return  zero if the data is mapped, else an error code and the file is 
+    *          read with crcb_read_file().
+    */
+    int crcb_file_get_mapped_data(const uint32_t fid,
+                                  const uint32_t offset,
+                                  const size_t bytes,
+                                  const uint8_t **ppData);
+  #endif  // def INCLUDE_FILE_MAPPED_READS
+
     /**
     * @brief   crcb_write_file
     * @details The device overrides this method to accept data for the specified 
-    *          file.
+    *          file.  With FILE_WRITE_PAGE_SIZE defined the data comes in whole 
+    *          aligned pages, except at the start and end of a transfer.  pData 
+    *          then stays unchanged until the next call returns, so the page can
+    *          be programmed while the next one fills.
     * @param   fid (input) which file
     * @param   offset (input) offset, negative value specifies current location.
     * @param   bytes (input) how many bytes to write
@@ -479,8 +576,58 @@ int crcb_ping_get_signal_strength(int8_t *rssi);
                                    const size_t offset,
                                    const size_t bytes_to_write);
 
+  #ifdef INCLUDE_FILE_RESUME
+    /// The progress of a file write.  The data from start_offset up to 
+    /// committed_offset has been given to crcb_write_file(), and crc32 is 
+    /// its CRC32.
+    typedef struct {
+        uint32_t    file_id;
+        uint32_t    transfer_id;
+        uint32_t    start_offset;       // request_offset at init
+        uint32_t    transfer_length;    // zero if there is no checkpoint
+        uint32_t    committed_offset;
+        uint32_t    crc32;
+    } cr_FileTransferCheckpoint;
+
+    /**
+    * @brief   crcb_file_save_checkpoint
+    * @details Called as a file write commits more data, and with a 
+    *          transfer_length of zero when it ends.  The stack keeps the 
+    *          latest checkpoint in RAM, which is enough to resume after a 
+    *          disconnect.  Store it in NVM to resume after a reset too.
+    * @param   cp (input) the checkpoint
+    * @return  returns zero or an error code
+    */
+    int crcb_file_save_checkpoint(const cr_FileTransferCheckpoint *cp);
+
+    /**
+    * @brief   crcb_file_load_checkpoint
+    * @details Called when a client resumes a write that the stack has no 
+    *          checkpoint for in RAM.
+    * @param   fid (input) which file
+    * @param   cp (output) the checkpoint last saved for the file
+    * @return  zero, or cr_ErrorCodes_NO_DATA if there is none.
+    */
+    int crcb_file_load_checkpoint(const uint32_t fid, cr_FileTransferCheckpoint *cp);
+  #endif  // def INCLUDE_FILE_RESUME
+
 #endif /// def INCLUDE_FILE_SERVICE
 
+    /**
+    * @brief   crcb_crc32
+    * @details A device with a CRC engine can override this to compute the 
+    *          CRC32 used to check file transfers.  It is the CRC32 of IEEE 
+    *          802.3 and zlib, polynomial 0x04C11DB7, reflected, initial value
+    *          and final XOR 0xFFFFFFFF.
+    * @param   crc (input) The CRC of the data so far, zero to start.
+    *              (output) The CRC including data.
+    * @param   data (input) The next bytes.
+    * @param   len (input) The number of bytes at data.
+    * @return  cr_ErrorCodes_NO_ERROR if computed, otherwise the stack computes
+    *          it in software.
+    */
+    int crcb_crc32(uint32_t *crc, const uint8_t *data, size_t len);
+
 #ifdef INCLUDE_TIME_SERVICE
     /**
     * @brief   crcb_time_get
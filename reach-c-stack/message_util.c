@@ -84,6 +84,12 @@ const char *msg_type_string(int32_t message_type) {
       return "Write Param";
   case cr_ReachMessageTypes_CONFIG_PARAM_NOTIFY:
       return "Config Param Notifiy";
+  case cr_ReachMessageTypes_CONFIG_PARAM_NOTIFY_LIST:
+      return "Config Param Notify List";
+  case cr_ReachMessageTypes_READ_LARGE_PARAM:
+      return "Read Large Param";
+  case cr_ReachMessageTypes_WRITE_LARGE_PARAM:
+      return "Write Large Param";
   case cr_ReachMessageTypes_PARAMETER_NOTIFICATION:
       return "Param Notification";
   case cr_ReachMessageTypes_DISCOVER_FILES:
@@ -151,6 +157,8 @@ char *message_util_get_device_info_response_json(
     cJSON_AddNumberToObject(json1, "hash", response->parameter_metadata_hash);
     // not yet: application_identifier
     cJSON_AddNumberToObject(json1, "endpoints", response->endpoints);
+    cJSON_AddNumberToObject(json1, "session token", response->session_token);
+    cJSON_AddBoolToObject(json1, "session resumed", response->session_resumed);
     cJSON_AddItemToObject(json, msg_type_string(cr_ReachMessageTypes_GET_DEVICE_INFO), json1);
 
     // convert the cJSON object to a JSON string
@@ -204,6 +212,16 @@ char *message_util_transfer_init_json(const cr_FileTransferInit *request) {
   cJSON_AddNumberToObject(json1, "transfer id", request->transfer_id);
   cJSON_AddNumberToObject(json1, "messages per ack", request->messages_per_ack);
   cJSON_AddNumberToObject(json1, "timeout", request->timeout_in_ms);
+  if (request->has_transfer_crc32)
+    cJSON_AddNumberToObject(json1, "transfer crc32", request->transfer_crc32);
+  if (request->selective_ack)
+    cJSON_AddBoolToObject(json1, "selective ack", request->selective_ack);
+  if (request->adaptive_ack_rate)
+    cJSON_AddBoolToObject(json1, "adaptive ack rate", request->adaptive_ack_rate);
+  if (request->compression != cr_FileCompression_NO_COMPRESSION)
+    cJSON_AddNumberToObject(json1, "compression", request->compression);
+  if (request->resume)
+    cJSON_AddBoolToObject(json1, "resume", request->resume);
 
   cJSON_AddItemToObject(json, msg_type_string(cr_ReachMessageTypes_TRANSFER_INIT), json1);
 
@@ -224,6 +242,17 @@ char *message_util_transfer_init_response_json(
   cJSON_AddNumberToObject(json1, "result", response->result);
   cJSON_AddNumberToObject(json1, "transfer_id", response->transfer_id);
   cJSON_AddNumberToObject(json1, "preferred_ack_rate", response->preferred_ack_rate);
+  if (response->selective_ack)
+    cJSON_AddBoolToObject(json1, "selective_ack", response->selective_ack);
+  if (response->adaptive_ack_rate)
+    cJSON_AddBoolToObject(json1, "adaptive_ack_rate", response->adaptive_ack_rate);
+  if (response->compression != cr_FileCompression_NO_COMPRESSION)
+    cJSON_AddNumberToObject(json1, "compression", response->compression);
+  if (response->resume)
+  {
+    cJSON_AddNumberToObject(json1, "resume_offset", response->resume_offset);
+    cJSON_AddNumberToObject(json1, "transfer_crc32", response->transfer_crc32);
+  }
   if (response->result != 0)
     cJSON_AddStringToObject(json1, "error_message", response->error_message);
   cJSON_AddItemToObject(json, msg_type_string(cr_ReachMessageTypes_TRANSFER_INIT), json1);
@@ -245,7 +274,8 @@ char *message_util_transfer_data_json(const cr_FileTransferData *request) {
   cJSON_AddNumberToObject(json1, "message number",  request->message_number);
   cJSON_AddNumberToObject(json1, "messsage size", request->message_data.size);
   // cJSON_AddRawToObject(json1, "messsage data", (char *)request->message_data.bytes);
-  cJSON_AddNumberToObject(json1, "crc32", request->crc32);
+  if (request->has_packet_crc32)
+    cJSON_AddNumberToObject(json1, "packet crc32", request->packet_crc32);
   cJSON_AddItemToObject(json, msg_type_string(cr_ReachMessageTypes_TRANSFER_DATA), json1);
 
   // convert the cJSON object to a JSON string
@@ -265,7 +295,8 @@ message_util_transfer_data_response_json(const cr_FileTransferData *request) {
   cJSON_AddNumberToObject(json1, "id", request->transfer_id);
   cJSON_AddNumberToObject(json1, "message number", request->message_number);
   // cJSON_AddRawToObject(json1, "messsage data", (char *)request->message_data.bytes);
-  cJSON_AddNumberToObject(json1, "crc32", request->crc32);
+  if (request->has_packet_crc32)
+    cJSON_AddNumberToObject(json1, "packet crc32", request->packet_crc32);
   cJSON_AddItemToObject(json, msg_type_string(cr_ReachMessageTypes_TRANSFER_DATA), json1);
 
   // convert the cJSON object to a JSON string
@@ -285,6 +316,12 @@ char *message_util_transfer_data_notification_json(
   cJSON_AddNumberToObject(json1, "result", request->result);
   cJSON_AddBoolToObject(json1, "is_complete", request->is_complete);
   cJSON_AddNumberToObject(json1, "transfer_id", request->transfer_id);
+  if (request->has_transfer_crc32)
+    cJSON_AddNumberToObject(json1, "transfer_crc32", request->transfer_crc32);
+  if (request->has_received_map)
+    cJSON_AddNumberToObject(json1, "received_map", request->received_map);
+  if (request->messages_per_ack != 0)
+    cJSON_AddNumberToObject(json1, "messages_per_ack", request->messages_per_ack);
   if (request->result != 0)
   {
     cJSON_AddNumberToObject(json1, "retry_offset", request->retry_offset);
@@ -301,6 +338,24 @@ char *message_util_transfer_data_notification_json(
   return json_str;
 }
 
+static void add_param_selectors_json(cJSON *json,
+                                     const cr_ParameterRange *ranges,
+                                     pb_size_t ranges_count,
+                                     const char *group_name) {
+  if (ranges_count > 0) {
+    cJSON *rangeArray = cJSON_CreateArray();
+    for (size_t i = 0; i < ranges_count; i++) {
+      cJSON *range = cJSON_CreateObject();
+      cJSON_AddNumberToObject(range, "first_id", ranges[i].first_id);
+      cJSON_AddNumberToObject(range, "last_id", ranges[i].last_id);
+      cJSON_AddItemToArray(rangeArray, range);
+    }
+    cJSON_AddItemToObject(json, "ranges", rangeArray);
+  }
+  if (group_name[0] != 0)
+    cJSON_AddStringToObject(json, "group_name", group_name);
+}
+
 char *message_util_param_info_json(const cr_ParameterInfoRequest *request) {
 
   // I3_LOG(LOG_MASK_REACH, "message_util_param_info_json\n");
@@ -315,6 +370,8 @@ char *message_util_param_info_json(const cr_ParameterInfoRequest *request) {
     }
   }
   cJSON_AddItemToObject(json, msg_type_string(cr_ReachMessageTypes_DISCOVER_PARAMETERS), jsonArray);
+  add_param_selectors_json(json, request->ranges, request->ranges_count,
+                           request->group_name);
   // convert the cJSON object to a JSON string
   char *json_str = cJSON_Print(json);
 
@@ -491,6 +548,8 @@ char *message_util_read_param_json(const cr_ParameterRead *request) {
     }
   }
   cJSON_AddItemToObject(json, msg_type_string(cr_ReachMessageTypes_READ_PARAMETERS), jsonArray);
+  add_param_selectors_json(json, request->ranges, request->ranges_count,
+                           request->group_name);
 
   // convert the cJSON object to a JSON string
   char *json_str = cJSON_Print(json);
@@ -644,6 +703,8 @@ char *message_util_write_param_json(const cr_ParameterWrite *payload) {
     }
     cJSON_AddItemToObject(json, msg_type_string(cr_ReachMessageTypes_WRITE_PARAMETERS), jsonArray);
   }
+  if (payload->write_without_response)
+    cJSON_AddBoolToObject(json, "write_without_response", true);
 
   // convert the cJSON object to a JSON string
   char *json_str = cJSON_Print(json);
@@ -37,6 +37,14 @@
 #define REACH_NUM_COMMANDS_IN_RESPONSE          6
 #define REACH_NUM_MEDIUM_STRUCTS_IN_MESSAGE     4
 #define REACH_COUNT_PARAM_DESC_IN_RESPONSE      2
+// Parameter selectors.  Sized so that the decoded requests fit the prompt
+// buffer, which cr_stack.c checks.  The encoded request is not checked:
+// with two ranges and a group name, a full list of large ID's exceeds 
+// REACH_MESSAGE_PAYLOAD_MAX, so such a client must list fewer ID's.
+#define REACH_COUNT_PARAM_RANGES                2
+#define REACH_PARAM_GROUP_NAME_LEN              8
+#define REACH_COUNT_NOTIFY_LIST_IDS             16
+#define REACH_LARGE_PARAM_CHUNK_LEN            176
 
 // These specific sizes and counts are defined in terms of a lesser number
 // of generic macros which are used in the reach.options file to set 
@@ -144,6 +144,36 @@ bool decode_reach_payload(cr_ReachMessageTypes message_type,     // in:  from th
                     message_util_config_notify_param_json((cr_ParameterNotifyConfigResponse *)data));
         }
         break;
+    case cr_ReachMessageTypes_CONFIG_PARAM_NOTIFY_LIST:
+        status = pb_decode(&is_stream, cr_ParameterNotifyConfigList_fields, data);
+        if (status) {
+          LOG_REACH("Parameter notify config list: %d IDs, %d ranges, group '%s'\n",
+                    ((cr_ParameterNotifyConfigList *)data)->parameter_ids_count,
+                    ((cr_ParameterNotifyConfigList *)data)->ranges_count,
+                    ((cr_ParameterNotifyConfigList *)data)->group_name);
+        }
+        break;
+  #ifdef INCLUDE_LARGE_PARAMETERS
+    case cr_ReachMessageTypes_READ_LARGE_PARAM:
+        status = pb_decode(&is_stream, cr_LargeParameterRead_fields, data);
+        if (status) {
+          LOG_REACH("Large parameter %d read: %d bytes at %d\n",
+                    ((cr_LargeParameterRead *)data)->parameter_id,
+                    ((cr_LargeParameterRead *)data)->length,
+                    ((cr_LargeParameterRead *)data)->offset);
+        }
+        break;
+    case cr_ReachMessageTypes_WRITE_LARGE_PARAM:
+        status = pb_decode(&is_stream, cr_LargeParameterWrite_fields, data);
+        if (status) {
+          LOG_REACH("Large parameter %d write: %d bytes at %d of %d\n",
+                    ((cr_LargeParameterWrite *)data)->parameter_id,
+                    ((cr_LargeParameterWrite *)data)->data.size,
+                    ((cr_LargeParameterWrite *)data)->offset,
+                    ((cr_LargeParameterWrite *)data)->total_size);
+        }
+        break;
+  #endif  // def INCLUDE_LARGE_PARAMETERS
 
 #endif  // def INCLUDE_PARAMETER_SERVICE
 
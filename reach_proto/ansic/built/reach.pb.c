@@ -27,6 +27,9 @@ PB_BIND(cr_DeviceInfoRequest, cr_DeviceInfoRequest, AUTO)
 PB_BIND(cr_DeviceInfoResponse, cr_DeviceInfoResponse, AUTO)
 
 
+PB_BIND(cr_ParameterRange, cr_ParameterRange, AUTO)
+
+
 PB_BIND(cr_ParameterInfoRequest, cr_ParameterInfoRequest, AUTO)
 
 
@@ -57,9 +60,24 @@ PB_BIND(cr_ParameterWriteResult, cr_ParameterWriteResult, AUTO)
 PB_BIND(cr_ParameterNotifyConfig, cr_ParameterNotifyConfig, AUTO)
 
 
+PB_BIND(cr_ParameterNotifyConfigList, cr_ParameterNotifyConfigList, AUTO)
+
+
 PB_BIND(cr_ParameterNotifyConfigResponse, cr_ParameterNotifyConfigResponse, AUTO)
 
 
+PB_BIND(cr_LargeParameterRead, cr_LargeParameterRead, AUTO)
+
+
+PB_BIND(cr_LargeParameterData, cr_LargeParameterData, AUTO)
+
+
+PB_BIND(cr_LargeParameterWrite, cr_LargeParameterWrite, AUTO)
+
+
+PB_BIND(cr_LargeParameterWriteResult, cr_LargeParameterWriteResult, AUTO)
+
+
 PB_BIND(cr_ParameterNotification, cr_ParameterNotification, AUTO)
 
 
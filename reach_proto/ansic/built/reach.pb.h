@@ -13,7 +13,7 @@
 /* Enum definitions */
 typedef enum _cr_ReachProtoVersion {
     cr_ReachProtoVersion_NOT_USED = 0, /* Must have a zero */
-    cr_ReachProtoVersion_CURRENT_VERSION = 12 /* update this when you change this file. */
+    cr_ReachProtoVersion_CURRENT_VERSION = 24 /* update this when you change this file. */
 } cr_ReachProtoVersion;
 
 typedef enum _cr_ReachMessageTypes {
@@ -28,6 +28,9 @@ typedef enum _cr_ReachMessageTypes {
     cr_ReachMessageTypes_WRITE_PARAMETERS = 8,
     cr_ReachMessageTypes_CONFIG_PARAM_NOTIFY = 9,
     cr_ReachMessageTypes_PARAMETER_NOTIFICATION = 10,
+    cr_ReachMessageTypes_CONFIG_PARAM_NOTIFY_LIST = 11, /* One notify config for many parameters */
+    cr_ReachMessageTypes_READ_LARGE_PARAM = 32, /* Reads a LARGE_BYTES parameter in chunks */
+    cr_ReachMessageTypes_WRITE_LARGE_PARAM = 33, /* Writes one chunk of a LARGE_BYTES parameter */
     /* File Transfers */
     cr_ReachMessageTypes_DISCOVER_FILES = 12,
     cr_ReachMessageTypes_TRANSFER_INIT = 13, /* Begins a Transfer */
@@ -79,7 +82,8 @@ typedef enum _cr_ParameterDataType {
     cr_ParameterDataType_STRING = 7, /* ASCII or UTF-8. Null Terminated. */
     cr_ParameterDataType_ENUMERATION = 8,
     cr_ParameterDataType_BIT_FIELD = 9,
-    cr_ParameterDataType_BYTE_ARRAY = 10
+    cr_ParameterDataType_BYTE_ARRAY = 10,
+    cr_ParameterDataType_LARGE_BYTES = 11 /* Read and written in chunks.  See LargeParameterRead. */
 } cr_ParameterDataType;
 
 typedef enum _cr_CLIType {
@@ -124,6 +128,7 @@ typedef enum _cr_ErrorCodes {
     cr_ErrorCodes_CHALLENGE_FAILED = 17,
     cr_ErrorCodes_PARAMETER_LOCKED = 18,
     cr_ErrorCodes_NO_RESOURCE = 19, /* as in no more param notification slots. */
+    cr_ErrorCodes_PENDING = 20, /* the result will be supplied later. */
     cr_ErrorCodes_ABORT = 1000 /* Operation cancellation */
 } cr_ErrorCodes;
 
@@ -135,6 +140,22 @@ typedef enum _cr_FileTransferState {
     cr_FileTransferState_COMPLETE = 4
 } cr_FileTransferState;
 
+/* With LZSS the message_data of a file read is a compressed stream, 
+ restarted at the first message after each ACK.  Lost messages are not 
+ resent.  A client that loses one starts a new read at the file offset it 
+ has decoded up to.  The server compresses one read at a time and refuses
+ another with NO_RESOURCE.
+ The data of each message is a series of groups: a flag byte, then up to 
+ 8 items, least significant flag bit first.  A set bit is a literal byte.  A clear bit is a two byte 
+ copy of earlier data: the first byte and the top 2 bits of the second are
+ the distance back, less 1.  The low 6 bits are the length, less 3.  
+ A message ends where its data ends, even part way through a group.
+ packet_crc32 covers the compressed data.  transfer_crc32 covers the file data. */
+typedef enum _cr_FileCompression {
+    cr_FileCompression_NO_COMPRESSION = 0,
+    cr_FileCompression_LZSS = 1
+} cr_FileCompression;
+
 typedef enum _cr_SizesOffsets {
     cr_SizesOffsets_MAX_MESSAGE_SIZE_OFFSET = 0, /* uint16_t, little endian */
     cr_SizesOffsets_BIG_DATA_BUFFER_SIZE_OFFSET = 2, /* uint16_t, little endian */
@@ -209,6 +230,11 @@ typedef struct _cr_DeviceInfoRequest {
  verification is needed. */
     bool has_challenge_key;
     uint32_t challenge_key;
+    /* (Optional) The session_token from the previous connection.
+ If it matches and the device has not timed out the session, the
+ notifications configured in that session continue. */
+    bool has_session_token;
+    uint32_t session_token;
 } cr_DeviceInfoRequest;
 
 typedef PB_BYTES_ARRAY_T(16) cr_DeviceInfoResponse_application_identifier_t;
@@ -229,17 +255,31 @@ typedef struct _cr_DeviceInfoResponse {
     cr_DeviceInfoResponse_application_identifier_t application_identifier; /* A UUID to find a Custom firmware_version */
     uint32_t endpoints; /* bit mask, non-zero if other endpoints. */
     cr_DeviceInfoResponse_sizes_struct_t sizes_struct; /* packed. See SizesOffsets */
+    uint32_t session_token; /* Present this when reconnecting. */
+    bool session_resumed; /* true if notifications were kept. */
 } cr_DeviceInfoResponse;
 
 /* ------------------------------------------------------
  Discover ParameterInfo
  DISCOVER_PARAMETERS
  dp / dp~
- ------------------------------------------------------ */
+ ------------------------------------------------------
+ A span of parameter ID's, first and last inclusive. */
+typedef struct _cr_ParameterRange {
+    uint32_t first_id;
+    uint32_t last_id;
+} cr_ParameterRange;
+
+/* Ranges and a group select parameters in addition to parameter_ids.
+ Selected parameters are returned once each, in discovery order.
+ DISCOVER_PARAM_EX uses only parameter_ids. */
 typedef struct _cr_ParameterInfoRequest {
     uint32_t parameter_key; /* Unlock Key */
     pb_size_t parameter_ids_count;
     uint32_t parameter_ids[32]; /* ID's to Fetch (Empty to Get All) */
+    pb_size_t ranges_count;
+    cr_ParameterRange ranges[2]; /* ID ranges to Fetch */
+    char group_name[8]; /* Named group defined by the device */
 } cr_ParameterInfoRequest;
 
 typedef struct _cr_ParameterInfo {
@@ -290,6 +330,9 @@ typedef struct _cr_ParameterRead {
     pb_size_t parameter_ids_count;
     uint32_t parameter_ids[32]; /* i: ID -  Leave Empty to Retrieve All */
     uint32_t read_after_timestamp; /* Allows for retrieval of only new / changed values. */
+    pb_size_t ranges_count;
+    cr_ParameterRange ranges[2]; /* ID ranges to Retrieve, as for discovery. */
+    char group_name[8]; /* Named group defined by the device */
 } cr_ParameterRead;
 
 typedef struct _cr_ParameterWriteResult {
@@ -306,12 +349,69 @@ typedef struct _cr_ParameterNotifyConfig {
     uint32_t minimum_notification_period; /* min_ms: Minimum Notification Interval (ms) */
     uint32_t maximum_notification_period; /* max_ms: Minimum Notification Interval (ms) */
     float minimum_delta; /* notify only if change by this much */
+    float hysteresis; /* extra change needed to reverse or to cross the setpoint */
+    float minimum_rate; /* also notify if changing faster than this per second */
+    bool has_setpoint;
+    float setpoint; /* if set, notify only on crossing this value */
 } cr_ParameterNotifyConfig;
 
+/* Applies the same notification settings to many parameters.
+ All of the selected parameters are configured or none are. */
+typedef struct _cr_ParameterNotifyConfigList {
+    bool has_settings;
+    cr_ParameterNotifyConfig settings; /* parameter_id is not used */
+    pb_size_t parameter_ids_count;
+    uint32_t parameter_ids[16]; /* IDs to configure */
+    pb_size_t ranges_count;
+    cr_ParameterRange ranges[2]; /* ID ranges to configure, as for discovery */
+    char group_name[8]; /* Named group defined by the device */
+} cr_ParameterNotifyConfigList;
+
 typedef struct _cr_ParameterNotifyConfigResponse {
     int32_t result; /* zero if all OK */
+    uint32_t num_configured; /* parameters configured by a list */
 } cr_ParameterNotifyConfigResponse;
 
+/* ------------------------------------------------------
+ Large Parameters
+ A LARGE_BYTES parameter can hold up to size_in_bytes bytes.  Ordinary 
+ reads give only the first bytes in bytes_value.  The whole value is read 
+ and written in chunks of up to REACH_LARGE_PARAM_CHUNK_LEN bytes.
+ ------------------------------------------------------ */
+typedef struct _cr_LargeParameterRead {
+    uint32_t parameter_id;
+    uint32_t offset; /* first byte to read */
+    uint32_t length; /* bytes to read, zero for all */
+} cr_LargeParameterRead;
+
+typedef PB_BYTES_ARRAY_T(176) cr_LargeParameterData_data_t;
+/* The device sends as many of these as needed to cover the read, as a 
+ continued transaction. */
+typedef struct _cr_LargeParameterData {
+    int32_t result; /* zero if OK */
+    uint32_t parameter_id;
+    uint32_t offset; /* of the first byte of data */
+    uint32_t total_size; /* current size of the whole value */
+    cr_LargeParameterData_data_t data;
+} cr_LargeParameterData;
+
+typedef PB_BYTES_ARRAY_T(176) cr_LargeParameterWrite_data_t;
+/* Chunks must be written in order, starting at offset zero.  The value 
+ takes its new size when the first chunk is written. */
+typedef struct _cr_LargeParameterWrite {
+    uint32_t parameter_id;
+    uint32_t offset; /* where this chunk goes */
+    uint32_t total_size; /* size of the whole new value */
+    cr_LargeParameterWrite_data_t data;
+} cr_LargeParameterWrite;
+
+typedef struct _cr_LargeParameterWriteResult {
+    int32_t result; /* zero if OK */
+    uint32_t parameter_id;
+    uint32_t offset; /* bytes received, where the next chunk goes */
+    bool is_complete; /* the whole value has been written */
+} cr_LargeParameterWriteResult;
+
 typedef PB_BYTES_ARRAY_T(32) cr_ParameterValue_bytes_value_t;
 /* --------------------------------------------------------
  Message for Sending / Receiving a Single Parameter Value
@@ -352,6 +452,11 @@ typedef struct _cr_ParameterReadResult {
 typedef struct _cr_ParameterWrite {
     bool has_parameter_key;
     uint32_t parameter_key; /* Optional Key for Unlocking Private Parameters */
+    bool write_without_response; /* No ParameterWriteResult is sent.  Failures
+ are sent as an ERROR_REPORT.  Only the latest
+ value per parameter may be applied.
+ Declared ahead of values to keep the C struct
+ within the prompt buffer. */
     pb_size_t values_count;
     cr_ParameterValue values[4]; /* Array of Write Values */
 } cr_ParameterWrite;
@@ -395,6 +500,12 @@ typedef struct _cr_FileTransferInit {
     uint32_t transfer_id; /* In case of multiple transfers */
     uint32_t messages_per_ack; /* number of messages before ACK. */
     uint32_t timeout_in_ms; /* ms before abandonment */
+    bool has_transfer_crc32;
+    uint32_t transfer_crc32; /* expected CRC32 of all data written */
+    bool selective_ack; /* write: ACK with a map of packets received */
+    bool adaptive_ack_rate; /* write: the server tunes messages_per_ack */
+    cr_FileCompression compression; /* read: compression requested */
+    bool resume; /* write: continue from the checkpoint */
 } cr_FileTransferInit;
 
 typedef struct _cr_FileTransferInitResponse {
@@ -402,6 +513,15 @@ typedef struct _cr_FileTransferInitResponse {
     uint32_t transfer_id; /* Transfer ID */
     uint32_t preferred_ack_rate; /* overrides request */
     char error_message[194];
+    bool selective_ack; /* the server grants selective_ack */
+    bool adaptive_ack_rate; /* the server grants adaptive_ack_rate */
+    cr_FileCompression compression; /* compression used, if any */
+    /* A resumed write continues at resume_offset.  transfer_crc32 is the
+ CRC32 of the data before it, from request_offset. */
+    bool resume; /* the server resumes the write */
+    uint32_t resume_offset; /* file offset of the next byte to send */
+    bool has_transfer_crc32;
+    uint32_t transfer_crc32;
 } cr_FileTransferInitResponse;
 
 typedef PB_BYTES_ARRAY_T(194) cr_FileTransferData_message_data_t;
@@ -412,7 +532,9 @@ typedef struct _cr_FileTransferData {
     uint32_t message_number; /* counts up */
     cr_FileTransferData_message_data_t message_data; /* Data */
     bool has_crc32;
-    int32_t crc32; /* Optional crc for integrity checking */
+    int32_t crc32; /* Deprecated and not checked.  Use packet_crc32. */
+    bool has_packet_crc32;
+    uint32_t packet_crc32; /* Optional CRC32 of message_data */
 } cr_FileTransferData;
 
 typedef struct _cr_FileTransferDataNotification {
@@ -421,6 +543,14 @@ typedef struct _cr_FileTransferDataNotification {
     bool is_complete;
     uint32_t transfer_id; /* Transfer ID */
     uint32_t retry_offset; /* file offset where error occurred */
+    bool has_transfer_crc32;
+    uint32_t transfer_crc32; /* CRC32 of all data transferred so far */
+    /* With selective_ack, bit n-1 is set if message n of this window arrived.
+ The client resends only the missing messages, with the same numbers. */
+    bool has_received_map;
+    uint32_t received_map;
+    /* With adaptive_ack_rate, the messages to send before the next ACK. */
+    uint32_t messages_per_ack;
 } cr_FileTransferDataNotification;
 
 typedef struct _cr_FileEraseRequest {
@@ -601,8 +731,8 @@ extern "C" {
 #define _cr_ReachProtoVersion_ARRAYSIZE ((cr_ReachProtoVersion)(cr_ReachProtoVersion_CURRENT_VERSION+1))
 
 #define _cr_ReachMessageTypes_MIN cr_ReachMessageTypes_INVALID
-#define _cr_ReachMessageTypes_MAX cr_ReachMessageTypes_GET_TIME
-#define _cr_ReachMessageTypes_ARRAYSIZE ((cr_ReachMessageTypes)(cr_ReachMessageTypes_GET_TIME+1))
+#define _cr_ReachMessageTypes_MAX cr_ReachMessageTypes_WRITE_LARGE_PARAM
+#define _cr_ReachMessageTypes_ARRAYSIZE ((cr_ReachMessageTypes)(cr_ReachMessageTypes_WRITE_LARGE_PARAM+1))
 
 #define _cr_ServiceIds_MIN cr_ServiceIds_NO_SVC_ID
 #define _cr_ServiceIds_MAX cr_ServiceIds_TIME
@@ -613,8 +743,8 @@ extern "C" {
 #define _cr_EndpointIds_ARRAYSIZE ((cr_EndpointIds)(cr_EndpointIds_FOUR+1))
 
 #define _cr_ParameterDataType_MIN cr_ParameterDataType_UINT32
-#define _cr_ParameterDataType_MAX cr_ParameterDataType_BYTE_ARRAY
-#define _cr_ParameterDataType_ARRAYSIZE ((cr_ParameterDataType)(cr_ParameterDataType_BYTE_ARRAY+1))
+#define _cr_ParameterDataType_MAX cr_ParameterDataType_LARGE_BYTES
+#define _cr_ParameterDataType_ARRAYSIZE ((cr_ParameterDataType)(cr_ParameterDataType_LARGE_BYTES+1))
 
 #define _cr_CLIType_MIN cr_CLIType_NO_CLI
 #define _cr_CLIType_MAX cr_CLIType_REPORT
@@ -636,6 +766,10 @@ extern "C" {
 #define _cr_FileTransferState_MAX cr_FileTransferState_COMPLETE
 #define _cr_FileTransferState_ARRAYSIZE ((cr_FileTransferState)(cr_FileTransferState_COMPLETE+1))
 
+#define _cr_FileCompression_MIN cr_FileCompression_NO_COMPRESSION
+#define _cr_FileCompression_MAX cr_FileCompression_LZSS
+#define _cr_FileCompression_ARRAYSIZE ((cr_FileCompression)(cr_FileCompression_LZSS+1))
+
 #define _cr_SizesOffsets_MIN cr_SizesOffsets_MAX_MESSAGE_SIZE_OFFSET
 #define _cr_SizesOffsets_MAX cr_SizesOffsets_STRUCTURE_SIZE
 #define _cr_SizesOffsets_ARRAYSIZE ((cr_SizesOffsets)(cr_SizesOffsets_STRUCTURE_SIZE+1))
@@ -669,7 +803,9 @@ extern "C" {
 #define cr_FileInfo_access_ENUMTYPE cr_AccessLevel
 #define cr_FileInfo_storage_location_ENUMTYPE cr_StorageLocation
 
+#define cr_FileTransferInit_compression_ENUMTYPE cr_FileCompression
 
+#define cr_FileTransferInitResponse_compression_ENUMTYPE cr_FileCompression
 
 
 
@@ -702,28 +838,34 @@ extern "C" {
 #define cr_ErrorReport_init_default              {0, ""}
 #define cr_PingRequest_init_default              {{0, {0}}}
 #define cr_PingResponse_init_default             {{0, {0}}, 0}
-#define cr_DeviceInfoRequest_init_default        {false, 0}
-#define cr_DeviceInfoResponse_init_default       {0, "", "", "", "", 0, 0, false, {0, {0}}, 0, {0, {0}}}
-#define cr_ParameterInfoRequest_init_default     {0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}
+#define cr_DeviceInfoRequest_init_default        {false, 0, false, 0}
+#define cr_DeviceInfoResponse_init_default       {0, "", "", "", "", 0, 0, false, {0, {0}}, 0, {0, {0}}, 0, 0}
+#define cr_ParameterRange_init_default   {0, 0}
+#define cr_ParameterInfoRequest_init_default     {0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, {cr_ParameterRange_init_default, cr_ParameterRange_init_default}, ""}
 #define cr_ParameterInfoResponse_init_default    {0, {cr_ParameterInfo_init_default, cr_ParameterInfo_init_default}}
 #define cr_ParameterInfo_init_default            {0, _cr_ParameterDataType_MIN, 0, "", _cr_AccessLevel_MIN, false, "", "", false, 0, false, 0, false, 0, _cr_StorageLocation_MIN}
 #define cr_ParamExKey_init_default               {0, ""}
 #define cr_ParamExInfoResponse_init_default      {0, _cr_ParameterDataType_MIN, 0, {cr_ParamExKey_init_default, cr_ParamExKey_init_default, cr_ParamExKey_init_default, cr_ParamExKey_init_default, cr_ParamExKey_init_default, cr_ParamExKey_init_default, cr_ParamExKey_init_default, cr_ParamExKey_init_default}}
-#define cr_ParameterRead_init_default            {false, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0}
+#define cr_ParameterRead_init_default            {false, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, 0, {cr_ParameterRange_init_default, cr_ParameterRange_init_default}, ""}
 #define cr_ParameterReadResult_init_default      {0, 0, {cr_ParameterValue_init_default, cr_ParameterValue_init_default, cr_ParameterValue_init_default, cr_ParameterValue_init_default}}
-#define cr_ParameterWrite_init_default           {false, 0, 0, {cr_ParameterValue_init_default, cr_ParameterValue_init_default, cr_ParameterValue_init_default, cr_ParameterValue_init_default}}
+#define cr_ParameterWrite_init_default           {false, 0, 0, 0, {cr_ParameterValue_init_default, cr_ParameterValue_init_default, cr_ParameterValue_init_default, cr_ParameterValue_init_default}}
 #define cr_ParameterWriteResult_init_default     {0}
-#define cr_ParameterNotifyConfig_init_default    {0, 0, 0, 0, 0}
-#define cr_ParameterNotifyConfigResponse_init_default {0}
+#define cr_ParameterNotifyConfig_init_default    {0, 0, 0, 0, 0, 0, 0, false, 0}
+#define cr_ParameterNotifyConfigList_init_default {false, cr_ParameterNotifyConfig_init_default, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, {cr_ParameterRange_init_default, cr_ParameterRange_init_default}, ""}
+#define cr_ParameterNotifyConfigResponse_init_default {0, 0}
+#define cr_LargeParameterRead_init_default       {0, 0, 0}
+#define cr_LargeParameterData_init_default       {0, 0, 0, 0, {0, {0}}}
+#define cr_LargeParameterWrite_init_default      {0, 0, 0, {0, {0}}}
+#define cr_LargeParameterWriteResult_init_default {0, 0, 0, 0}
 #define cr_ParameterNotification_init_default    {0, {cr_ParameterValue_init_default, cr_ParameterValue_init_default, cr_ParameterValue_init_default, cr_ParameterValue_init_default}}
 #define cr_ParameterValue_init_default           {0, 0, 0, {0}}
 #define cr_DiscoverFiles_init_default            {0}
 #define cr_DiscoverFilesResponse_init_default    {0, {cr_FileInfo_init_default, cr_FileInfo_init_default, cr_FileInfo_init_default, cr_FileInfo_init_default}}
 #define cr_FileInfo_init_default                 {0, "", _cr_AccessLevel_MIN, 0, _cr_StorageLocation_MIN}
-#define cr_FileTransferInit_init_default         {0, 0, 0, 0, 0, 0, 0}
-#define cr_FileTransferInitResponse_init_default {0, 0, 0, ""}
-#define cr_FileTransferData_init_default         {0, 0, 0, {0, {0}}, false, 0}
-#define cr_FileTransferDataNotification_init_default {0, "", 0, 0, 0}
+#define cr_FileTransferInit_init_default         {0, 0, 0, 0, 0, 0, 0, false, 0, 0, 0, _cr_FileCompression_MIN, 0}
+#define cr_FileTransferInitResponse_init_default {0, 0, 0, "", 0, 0, _cr_FileCompression_MIN, 0, 0, false, 0}
+#define cr_FileTransferData_init_default         {0, 0, 0, {0, {0}}, false, 0, false, 0}
+#define cr_FileTransferDataNotification_init_default {0, "", 0, 0, 0, false, 0, false, 0, 0}
 #define cr_FileEraseRequest_init_default         {0}
 #define cr_FileEraseResponse_init_default        {0, 0, ""}
 #define cr_DiscoverStreams_init_default          {0}
@@ -749,28 +891,34 @@ extern "C" {
 #define cr_ErrorReport_init_zero                 {0, ""}
 #define cr_PingRequest_init_zero                 {{0, {0}}}
 #define cr_PingResponse_init_zero                {{0, {0}}, 0}
-#define cr_DeviceInfoRequest_init_zero           {false, 0}
-#define cr_DeviceInfoResponse_init_zero          {0, "", "", "", "", 0, 0, false, {0, {0}}, 0, {0, {0}}}
-#define cr_ParameterInfoRequest_init_zero        {0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}
+#define cr_DeviceInfoRequest_init_zero           {false, 0, false, 0}
+#define cr_DeviceInfoResponse_init_zero          {0, "", "", "", "", 0, 0, false, {0, {0}}, 0, {0, {0}}, 0, 0}
+#define cr_ParameterRange_init_zero      {0, 0}
+#define cr_ParameterInfoRequest_init_zero        {0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, {cr_ParameterRange_init_zero, cr_ParameterRange_init_zero}, ""}
 #define cr_ParameterInfoResponse_init_zero       {0, {cr_ParameterInfo_init_zero, cr_ParameterInfo_init_zero}}
 #define cr_ParameterInfo_init_zero               {0, _cr_ParameterDataType_MIN, 0, "", _cr_AccessLevel_MIN, false, "", "", false, 0, false, 0, false, 0, _cr_StorageLocation_MIN}
 #define cr_ParamExKey_init_zero                  {0, ""}
 #define cr_ParamExInfoResponse_init_zero         {0, _cr_ParameterDataType_MIN, 0, {cr_ParamExKey_init_zero, cr_ParamExKey_init_zero, cr_ParamExKey_init_zero, cr_ParamExKey_init_zero, cr_ParamExKey_init_zero, cr_ParamExKey_init_zero, cr_ParamExKey_init_zero, cr_ParamExKey_init_zero}}
-#define cr_ParameterRead_init_zero               {false, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0}
+#define cr_ParameterRead_init_zero               {false, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, 0, {cr_ParameterRange_init_zero, cr_ParameterRange_init_zero}, ""}
 #define cr_ParameterReadResult_init_zero         {0, 0, {cr_ParameterValue_init_zero, cr_ParameterValue_init_zero, cr_ParameterValue_init_zero, cr_ParameterValue_init_zero}}
-#define cr_ParameterWrite_init_zero              {false, 0, 0, {cr_ParameterValue_init_zero, cr_ParameterValue_init_zero, cr_ParameterValue_init_zero, cr_ParameterValue_init_zero}}
+#define cr_ParameterWrite_init_zero              {false, 0, 0, 0, {cr_ParameterValue_init_zero, cr_ParameterValue_init_zero, cr_ParameterValue_init_zero, cr_ParameterValue_init_zero}}
 #define cr_ParameterWriteResult_init_zero        {0}
-#define cr_ParameterNotifyConfig_init_zero       {0, 0, 0, 0, 0}
-#define cr_ParameterNotifyConfigResponse_init_zero {0}
+#define cr_ParameterNotifyConfig_init_zero       {0, 0, 0, 0, 0, 0, 0, false, 0}
+#define cr_ParameterNotifyConfigList_init_zero   {false, cr_ParameterNotifyConfig_init_zero, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, {cr_ParameterRange_init_zero, cr_ParameterRange_init_zero}, ""}
+#define cr_ParameterNotifyConfigResponse_init_zero {0, 0}
+#define cr_LargeParameterRead_init_zero          {0, 0, 0}
+#define cr_LargeParameterData_init_zero          {0, 0, 0, 0, {0, {0}}}
+#define cr_LargeParameterWrite_init_zero         {0, 0, 0, {0, {0}}}
+#define cr_LargeParameterWriteResult_init_zero   {0, 0, 0, 0}
 #define cr_ParameterNotification_init_zero       {0, {cr_ParameterValue_init_zero, cr_ParameterValue_init_zero, cr_ParameterValue_init_zero, cr_ParameterValue_init_zero}}
 #define cr_ParameterValue_init_zero              {0, 0, 0, {0}}
 #define cr_DiscoverFiles_init_zero               {0}
 #define cr_DiscoverFilesResponse_init_zero       {0, {cr_FileInfo_init_zero, cr_FileInfo_init_zero, cr_FileInfo_init_zero, cr_FileInfo_init_zero}}
 #define cr_FileInfo_init_zero                    {0, "", _cr_AccessLevel_MIN, 0, _cr_StorageLocation_MIN}
-#define cr_FileTransferInit_init_zero            {0, 0, 0, 0, 0, 0, 0}
-#define cr_FileTransferInitResponse_init_zero    {0, 0, 0, ""}
-#define cr_FileTransferData_init_zero            {0, 0, 0, {0, {0}}, false, 0}
-#define cr_FileTransferDataNotification_init_zero {0, "", 0, 0, 0}
+#define cr_FileTransferInit_init_zero            {0, 0, 0, 0, 0, 0, 0, false, 0, 0, 0, _cr_FileCompression_MIN, 0}
+#define cr_FileTransferInitResponse_init_zero    {0, 0, 0, "", 0, 0, _cr_FileCompression_MIN, 0, 0, false, 0}
+#define cr_FileTransferData_init_zero            {0, 0, 0, {0, {0}}, false, 0, false, 0}
+#define cr_FileTransferDataNotification_init_zero {0, "", 0, 0, 0, false, 0, false, 0, 0}
 #define cr_FileEraseRequest_init_zero            {0}
 #define cr_FileEraseResponse_init_zero           {0, 0, ""}
 #define cr_DiscoverStreams_init_zero             {0}
@@ -806,6 +954,7 @@ extern "C" {
 #define cr_PingResponse_echo_data_tag            1
 #define cr_PingResponse_signal_strength_tag      2
 #define cr_DeviceInfoRequest_challenge_key_tag   1
+#define cr_DeviceInfoRequest_session_token_tag   2
 #define cr_DeviceInfoResponse_protocol_version_tag 1
 #define cr_DeviceInfoResponse_device_name_tag    2
 #define cr_DeviceInfoResponse_manufacturer_tag   3
@@ -816,8 +965,14 @@ extern "C" {
 #define cr_DeviceInfoResponse_application_identifier_tag 10
 #define cr_DeviceInfoResponse_endpoints_tag      11
 #define cr_DeviceInfoResponse_sizes_struct_tag   20
+#define cr_DeviceInfoResponse_session_token_tag  21
+#define cr_DeviceInfoResponse_session_resumed_tag 22
+#define cr_ParameterRange_first_id_tag           1
+#define cr_ParameterRange_last_id_tag            2
 #define cr_ParameterInfoRequest_parameter_key_tag 1
 #define cr_ParameterInfoRequest_parameter_ids_tag 2
+#define cr_ParameterInfoRequest_ranges_tag       3
+#define cr_ParameterInfoRequest_group_name_tag   4
 #define cr_ParameterInfo_id_tag                  1
 #define cr_ParameterInfo_data_type_tag           2
 #define cr_ParameterInfo_size_in_bytes_tag       3
@@ -838,13 +993,39 @@ extern "C" {
 #define cr_ParameterRead_parameter_key_tag       1
 #define cr_ParameterRead_parameter_ids_tag       2
 #define cr_ParameterRead_read_after_timestamp_tag 3
+#define cr_ParameterRead_ranges_tag              4
+#define cr_ParameterRead_group_name_tag          5
 #define cr_ParameterWriteResult_result_tag       1
 #define cr_ParameterNotifyConfig_parameter_id_tag 1
 #define cr_ParameterNotifyConfig_enabled_tag     2
 #define cr_ParameterNotifyConfig_minimum_notification_period_tag 3
 #define cr_ParameterNotifyConfig_maximum_notification_period_tag 4
 #define cr_ParameterNotifyConfig_minimum_delta_tag 5
+#define cr_ParameterNotifyConfig_hysteresis_tag  6
+#define cr_ParameterNotifyConfig_minimum_rate_tag 7
+#define cr_ParameterNotifyConfig_setpoint_tag    8
+#define cr_ParameterNotifyConfigList_settings_tag 1
+#define cr_ParameterNotifyConfigList_parameter_ids_tag 2
+#define cr_ParameterNotifyConfigList_ranges_tag  3
+#define cr_ParameterNotifyConfigList_group_name_tag 4
 #define cr_ParameterNotifyConfigResponse_result_tag 1
+#define cr_ParameterNotifyConfigResponse_num_configured_tag 2
+#define cr_LargeParameterRead_parameter_id_tag   1
+#define cr_LargeParameterRead_offset_tag         2
+#define cr_LargeParameterRead_length_tag         3
+#define cr_LargeParameterData_result_tag         1
+#define cr_LargeParameterData_parameter_id_tag   2
+#define cr_LargeParameterData_offset_tag         3
+#define cr_LargeParameterData_total_size_tag     4
+#define cr_LargeParameterData_data_tag           5
+#define cr_LargeParameterWrite_parameter_id_tag  1
+#define cr_LargeParameterWrite_offset_tag        2
+#define cr_LargeParameterWrite_total_size_tag    3
+#define cr_LargeParameterWrite_data_tag          4
+#define cr_LargeParameterWriteResult_result_tag  1
+#define cr_LargeParameterWriteResult_parameter_id_tag 2
+#define cr_LargeParameterWriteResult_offset_tag  3
+#define cr_LargeParameterWriteResult_is_complete_tag 4
 #define cr_ParameterValue_parameter_id_tag       1
 #define cr_ParameterValue_timestamp_tag          2
 #define cr_ParameterValue_uint32_value_tag       3
@@ -862,6 +1043,7 @@ extern "C" {
 #define cr_ParameterReadResult_values_tag        3
 #define cr_ParameterWrite_parameter_key_tag      1
 #define cr_ParameterWrite_values_tag             3
+#define cr_ParameterWrite_write_without_response_tag 4
 #define cr_ParameterNotification_values_tag      2
 #define cr_FileInfo_file_id_tag                  1
 #define cr_FileInfo_file_name_tag                2
@@ -876,20 +1058,35 @@ extern "C" {
 #define cr_FileTransferInit_transfer_id_tag      5
 #define cr_FileTransferInit_messages_per_ack_tag 6
 #define cr_FileTransferInit_timeout_in_ms_tag    7
+#define cr_FileTransferInit_transfer_crc32_tag   8
+#define cr_FileTransferInit_selective_ack_tag    9
+#define cr_FileTransferInit_adaptive_ack_rate_tag 10
+#define cr_FileTransferInit_compression_tag      11
+#define cr_FileTransferInit_resume_tag           12
 #define cr_FileTransferInitResponse_result_tag   1
 #define cr_FileTransferInitResponse_transfer_id_tag 2
 #define cr_FileTransferInitResponse_preferred_ack_rate_tag 3
 #define cr_FileTransferInitResponse_error_message_tag 4
+#define cr_FileTransferInitResponse_selective_ack_tag 5
+#define cr_FileTransferInitResponse_adaptive_ack_rate_tag 6
+#define cr_FileTransferInitResponse_compression_tag 7
+#define cr_FileTransferInitResponse_resume_tag   8
+#define cr_FileTransferInitResponse_resume_offset_tag 9
+#define cr_FileTransferInitResponse_transfer_crc32_tag 10
 #define cr_FileTransferData_result_tag           1
 #define cr_FileTransferData_transfer_id_tag      2
 #define cr_FileTransferData_message_number_tag   3
 #define cr_FileTransferData_message_data_tag     4
 #define cr_FileTransferData_crc32_tag            5
+#define cr_FileTransferData_packet_crc32_tag     6
 #define cr_FileTransferDataNotification_result_tag 1
 #define cr_FileTransferDataNotification_error_message_tag 2
 #define cr_FileTransferDataNotification_is_complete_tag 3
 #define cr_FileTransferDataNotification_transfer_id_tag 4
 #define cr_FileTransferDataNotification_retry_offset_tag 5
+#define cr_FileTransferDataNotification_transfer_crc32_tag 6
+#define cr_FileTransferDataNotification_received_map_tag 7
+#define cr_FileTransferDataNotification_messages_per_ack_tag 8
 #define cr_FileEraseRequest_file_id_tag          1
 #define cr_FileEraseResponse_file_id_tag         1
 #define cr_FileEraseResponse_result_tag          2
@@ -973,7 +1170,8 @@ X(a, STATIC,   SINGULAR, INT32,    signal_strength,   2)
 #define cr_PingResponse_DEFAULT NULL
 
 #define cr_DeviceInfoRequest_FIELDLIST(X, a) \
-X(a, STATIC,   OPTIONAL, UINT32,   challenge_key,     1)
+X(a, STATIC,   OPTIONAL, UINT32,   challenge_key,     1) \
+X(a, STATIC,   OPTIONAL, FIXED32,  session_token,     2)
 #define cr_DeviceInfoRequest_CALLBACK NULL
 #define cr_DeviceInfoRequest_DEFAULT NULL
 
@@ -987,15 +1185,26 @@ X(a, STATIC,   SINGULAR, UINT32,   services,          8) \
 X(a, STATIC,   SINGULAR, UINT32,   parameter_metadata_hash,   9) \
 X(a, STATIC,   OPTIONAL, BYTES,    application_identifier,  10) \
 X(a, STATIC,   SINGULAR, UINT32,   endpoints,        11) \
-X(a, STATIC,   SINGULAR, BYTES,    sizes_struct,     20)
+X(a, STATIC,   SINGULAR, BYTES,    sizes_struct,     20) \
+X(a, STATIC,   SINGULAR, FIXED32,  session_token,    21) \
+X(a, STATIC,   SINGULAR, BOOL,     session_resumed,  22)
 #define cr_DeviceInfoResponse_CALLBACK NULL
 #define cr_DeviceInfoResponse_DEFAULT NULL
 
+#define cr_ParameterRange_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   first_id,          1) \
+X(a, STATIC,   SINGULAR, UINT32,   last_id,           2)
+#define cr_ParameterRange_CALLBACK NULL
+#define cr_ParameterRange_DEFAULT NULL
+
 #define cr_ParameterInfoRequest_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, UINT32,   parameter_key,     1) \
-X(a, STATIC,   REPEATED, UINT32,   parameter_ids,     2)
+X(a, STATIC,   REPEATED, UINT32,   parameter_ids,     2) \
+X(a, STATIC,   REPEATED, MESSAGE,  ranges,            3) \
+X(a, STATIC,   SINGULAR, STRING,   group_name,        4)
 #define cr_ParameterInfoRequest_CALLBACK NULL
 #define cr_ParameterInfoRequest_DEFAULT NULL
+#define cr_ParameterInfoRequest_ranges_MSGTYPE cr_ParameterRange
 
 #define cr_ParameterInfoResponse_FIELDLIST(X, a) \
 X(a, STATIC,   REPEATED, MESSAGE,  parameter_infos,   1)
@@ -1035,9 +1244,12 @@ X(a, STATIC,   REPEATED, MESSAGE,  enumerations,      3)
 #define cr_ParameterRead_FIELDLIST(X, a) \
 X(a, STATIC,   OPTIONAL, UINT32,   parameter_key,     1) \
 X(a, STATIC,   REPEATED, UINT32,   parameter_ids,     2) \
-X(a, STATIC,   SINGULAR, UINT32,   read_after_timestamp,   3)
+X(a, STATIC,   SINGULAR, UINT32,   read_after_timestamp,   3) \
+X(a, STATIC,   REPEATED, MESSAGE,  ranges,            4) \
+X(a, STATIC,   SINGULAR, STRING,   group_name,        5)
 #define cr_ParameterRead_CALLBACK NULL
 #define cr_ParameterRead_DEFAULT NULL
+#define cr_ParameterRead_ranges_MSGTYPE cr_ParameterRange
 
 #define cr_ParameterReadResult_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, UINT32,   read_timestamp,    1) \
@@ -1048,7 +1260,8 @@ X(a, STATIC,   REPEATED, MESSAGE,  values,            3)
 
 #define cr_ParameterWrite_FIELDLIST(X, a) \
 X(a, STATIC,   OPTIONAL, UINT32,   parameter_key,     1) \
-X(a, STATIC,   REPEATED, MESSAGE,  values,            3)
+X(a, STATIC,   REPEATED, MESSAGE,  values,            3) \
+X(a, STATIC,   SINGULAR, BOOL,     write_without_response,   4)
 #define cr_ParameterWrite_CALLBACK NULL
 #define cr_ParameterWrite_DEFAULT NULL
 #define cr_ParameterWrite_values_MSGTYPE cr_ParameterValue
@@ -1063,15 +1276,61 @@ X(a, STATIC,   SINGULAR, UINT32,   parameter_id,      1) \
 X(a, STATIC,   SINGULAR, BOOL,     enabled,           2) \
 X(a, STATIC,   SINGULAR, UINT32,   minimum_notification_period,   3) \
 X(a, STATIC,   SINGULAR, UINT32,   maximum_notification_period,   4) \
-X(a, STATIC,   SINGULAR, FLOAT,    minimum_delta,     5)
+X(a, STATIC,   SINGULAR, FLOAT,    minimum_delta,     5) \
+X(a, STATIC,   SINGULAR, FLOAT,    hysteresis,        6) \
+X(a, STATIC,   SINGULAR, FLOAT,    minimum_rate,      7) \
+X(a, STATIC,   OPTIONAL, FLOAT,    setpoint,          8)
 #define cr_ParameterNotifyConfig_CALLBACK NULL
 #define cr_ParameterNotifyConfig_DEFAULT NULL
 
+#define cr_ParameterNotifyConfigList_FIELDLIST(X, a) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  settings,          1) \
+X(a, STATIC,   REPEATED, UINT32,   parameter_ids,     2) \
+X(a, STATIC,   REPEATED, MESSAGE,  ranges,            3) \
+X(a, STATIC,   SINGULAR, STRING,   group_name,        4)
+#define cr_ParameterNotifyConfigList_CALLBACK NULL
+#define cr_ParameterNotifyConfigList_DEFAULT NULL
+#define cr_ParameterNotifyConfigList_settings_MSGTYPE cr_ParameterNotifyConfig
+#define cr_ParameterNotifyConfigList_ranges_MSGTYPE cr_ParameterRange
+
 #define cr_ParameterNotifyConfigResponse_FIELDLIST(X, a) \
-X(a, STATIC,   SINGULAR, INT32,    result,            1)
+X(a, STATIC,   SINGULAR, INT32,    result,            1) \
+X(a, STATIC,   SINGULAR, UINT32,   num_configured,    2)
 #define cr_ParameterNotifyConfigResponse_CALLBACK NULL
 #define cr_ParameterNotifyConfigResponse_DEFAULT NULL
 
+#define cr_LargeParameterRead_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   parameter_id,      1) \
+X(a, STATIC,   SINGULAR, UINT32,   offset,            2) \
+X(a, STATIC,   SINGULAR, UINT32,   length,            3)
+#define cr_LargeParameterRead_CALLBACK NULL
+#define cr_LargeParameterRead_DEFAULT NULL
+
+#define cr_LargeParameterData_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, INT32,    result,            1) \
+X(a, STATIC,   SINGULAR, UINT32,   parameter_id,      2) \
+X(a, STATIC,   SINGULAR, UINT32,   offset,            3) \
+X(a, STATIC,   SINGULAR, UINT32,   total_size,        4) \
+X(a, STATIC,   SINGULAR, BYTES,    data,              5)
+#define cr_LargeParameterData_CALLBACK NULL
+#define cr_LargeParameterData_DEFAULT NULL
+
+#define cr_LargeParameterWrite_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   parameter_id,      1) \
+X(a, STATIC,   SINGULAR, UINT32,   offset,            2) \
+X(a, STATIC,   SINGULAR, UINT32,   total_size,        3) \
+X(a, STATIC,   SINGULAR, BYTES,    data,              4)
+#define cr_LargeParameterWrite_CALLBACK NULL
+#define cr_LargeParameterWrite_DEFAULT NULL
+
+#define cr_LargeParameterWriteResult_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, INT32,    result,            1) \
+X(a, STATIC,   SINGULAR, UINT32,   parameter_id,      2) \
+X(a, STATIC,   SINGULAR, UINT32,   offset,            3) \
+X(a, STATIC,   SINGULAR, BOOL,     is_complete,       4)
+#define cr_LargeParameterWriteResult_CALLBACK NULL
+#define cr_LargeParameterWriteResult_DEFAULT NULL
+
 #define cr_ParameterNotification_FIELDLIST(X, a) \
 X(a, STATIC,   REPEATED, MESSAGE,  values,            2)
 #define cr_ParameterNotification_CALLBACK NULL
@@ -1122,7 +1381,12 @@ X(a, STATIC,   SINGULAR, UINT32,   request_offset,    3) \
 X(a, STATIC,   SINGULAR, UINT32,   transfer_length,   4) \
 X(a, STATIC,   SINGULAR, UINT32,   transfer_id,       5) \
 X(a, STATIC,   SINGULAR, UINT32,   messages_per_ack,   6) \
-X(a, STATIC,   SINGULAR, UINT32,   timeout_in_ms,     7)
+X(a, STATIC,   SINGULAR, UINT32,   timeout_in_ms,     7) \
+X(a, STATIC,   OPTIONAL, FIXED32,  transfer_crc32,    8) \
+X(a, STATIC,   SINGULAR, BOOL,     selective_ack,     9) \
+X(a, STATIC,   SINGULAR, BOOL,     adaptive_ack_rate,  10) \
+X(a, STATIC,   SINGULAR, UENUM,    compression,      11) \
+X(a, STATIC,   SINGULAR, BOOL,     resume,           12)
 #define cr_FileTransferInit_CALLBACK NULL
 #define cr_FileTransferInit_DEFAULT NULL
 
@@ -1130,7 +1394,13 @@ X(a, STATIC,   SINGULAR, UINT32,   timeout_in_ms,     7)
 X(a, STATIC,   SINGULAR, INT32,    result,            1) \
 X(a, STATIC,   SINGULAR, UINT32,   transfer_id,       2) \
 X(a, STATIC,   SINGULAR, UINT32,   preferred_ack_rate,   3) \
-X(a, STATIC,   SINGULAR, STRING,   error_message,     4)
+X(a, STATIC,   SINGULAR, STRING,   error_message,     4) \
+X(a, STATIC,   SINGULAR, BOOL,     selective_ack,     5) \
+X(a, STATIC,   SINGULAR, BOOL,     adaptive_ack_rate,   6) \
+X(a, STATIC,   SINGULAR, UENUM,    compression,       7) \
+X(a, STATIC,   SINGULAR, BOOL,     resume,            8) \
+X(a, STATIC,   SINGULAR, UINT32,   resume_offset,     9) \
+X(a, STATIC,   OPTIONAL, FIXED32,  transfer_crc32,   10)
 #define cr_FileTransferInitResponse_CALLBACK NULL
 #define cr_FileTransferInitResponse_DEFAULT NULL
 
@@ -1139,7 +1409,8 @@ X(a, STATIC,   SINGULAR, INT32,    result,            1) \
 X(a, STATIC,   SINGULAR, UINT32,   transfer_id,       2) \
 X(a, STATIC,   SINGULAR, UINT32,   message_number,    3) \
 X(a, STATIC,   SINGULAR, BYTES,    message_data,      4) \
-X(a, STATIC,   OPTIONAL, INT32,    crc32,             5)
+X(a, STATIC,   OPTIONAL, INT32,    crc32,             5) \
+X(a, STATIC,   OPTIONAL, FIXED32,  packet_crc32,      6)
 #define cr_FileTransferData_CALLBACK NULL
 #define cr_FileTransferData_DEFAULT NULL
 
@@ -1148,7 +1419,10 @@ X(a, STATIC,   SINGULAR, INT32,    result,            1) \
 X(a, STATIC,   SINGULAR, STRING,   error_message,     2) \
 X(a, STATIC,   SINGULAR, BOOL,     is_complete,       3) \
 X(a, STATIC,   SINGULAR, UINT32,   transfer_id,       4) \
-X(a, STATIC,   SINGULAR, UINT32,   retry_offset,      5)
+X(a, STATIC,   SINGULAR, UINT32,   retry_offset,      5) \
+X(a, STATIC,   OPTIONAL, FIXED32,  transfer_crc32,    6) \
+X(a, STATIC,   OPTIONAL, FIXED32,  received_map,      7) \
+X(a, STATIC,   SINGULAR, UINT32,   messages_per_ack,   8)
 #define cr_FileTransferDataNotification_CALLBACK NULL
 #define cr_FileTransferDataNotification_DEFAULT NULL
 
@@ -1291,6 +1565,7 @@ extern const pb_msgdesc_t cr_PingRequest_msg;
 extern const pb_msgdesc_t cr_PingResponse_msg;
 extern const pb_msgdesc_t cr_DeviceInfoRequest_msg;
 extern const pb_msgdesc_t cr_DeviceInfoResponse_msg;
+extern const pb_msgdesc_t cr_ParameterRange_msg;
 extern const pb_msgdesc_t cr_ParameterInfoRequest_msg;
 extern const pb_msgdesc_t cr_ParameterInfoResponse_msg;
 extern const pb_msgdesc_t cr_ParameterInfo_msg;
@@ -1301,7 +1576,12 @@ extern const pb_msgdesc_t cr_ParameterReadResult_msg;
 extern const pb_msgdesc_t cr_ParameterWrite_msg;
 extern const pb_msgdesc_t cr_ParameterWriteResult_msg;
 extern const pb_msgdesc_t cr_ParameterNotifyConfig_msg;
+extern const pb_msgdesc_t cr_ParameterNotifyConfigList_msg;
 extern const pb_msgdesc_t cr_ParameterNotifyConfigResponse_msg;
+extern const pb_msgdesc_t cr_LargeParameterRead_msg;
+extern const pb_msgdesc_t cr_LargeParameterData_msg;
+extern const pb_msgdesc_t cr_LargeParameterWrite_msg;
+extern const pb_msgdesc_t cr_LargeParameterWriteResult_msg;
 extern const pb_msgdesc_t cr_ParameterNotification_msg;
 extern const pb_msgdesc_t cr_ParameterValue_msg;
 extern const pb_msgdesc_t cr_DiscoverFiles_msg;
@@ -1340,6 +1620,7 @@ extern const pb_msgdesc_t cr_BufferSizes_msg;
 #define cr_PingResponse_fields &cr_PingResponse_msg
 #define cr_DeviceInfoRequest_fields &cr_DeviceInfoRequest_msg
 #define cr_DeviceInfoResponse_fields &cr_DeviceInfoResponse_msg
+#define cr_ParameterRange_fields &cr_ParameterRange_msg
 #define cr_ParameterInfoRequest_fields &cr_ParameterInfoRequest_msg
 #define cr_ParameterInfoResponse_fields &cr_ParameterInfoResponse_msg
 #define cr_ParameterInfo_fields &cr_ParameterInfo_msg
@@ -1350,7 +1631,12 @@ extern const pb_msgdesc_t cr_BufferSizes_msg;
 #define cr_ParameterWrite_fields &cr_ParameterWrite_msg
 #define cr_ParameterWriteResult_fields &cr_ParameterWriteResult_msg
 #define cr_ParameterNotifyConfig_fields &cr_ParameterNotifyConfig_msg
+#define cr_ParameterNotifyConfigList_fields &cr_ParameterNotifyConfigList_msg
 #define cr_ParameterNotifyConfigResponse_fields &cr_ParameterNotifyConfigResponse_msg
+#define cr_LargeParameterRead_fields &cr_LargeParameterRead_msg
+#define cr_LargeParameterData_fields &cr_LargeParameterData_msg
+#define cr_LargeParameterWrite_fields &cr_LargeParameterWrite_msg
+#define cr_LargeParameterWriteResult_fields &cr_LargeParameterWriteResult_msg
 #define cr_ParameterNotification_fields &cr_ParameterNotification_msg
 #define cr_ParameterValue_fields &cr_ParameterValue_msg
 #define cr_DiscoverFiles_fields &cr_DiscoverFiles_msg
@@ -1385,8 +1671,8 @@ extern const pb_msgdesc_t cr_BufferSizes_msg;
 #define cr_BufferSizes_size                      78
 #define cr_CLIData_size                          198
 #define cr_CommandInfo_size                      31
-#define cr_DeviceInfoRequest_size                6
-#define cr_DeviceInfoResponse_size               182
+#define cr_DeviceInfoRequest_size                11
+#define cr_DeviceInfoResponse_size               191
 #define cr_DiscoverCommandsResponse_size         198
 #define cr_DiscoverCommands_size                 0
 #define cr_DiscoverFilesResponse_size            192
@@ -1397,23 +1683,29 @@ extern const pb_msgdesc_t cr_BufferSizes_msg;
 #define cr_FileEraseRequest_size                 6
 #define cr_FileEraseResponse_size                213
 #define cr_FileInfo_size                         46
-#define cr_FileTransferDataNotification_size     221
-#define cr_FileTransferData_size                 231
-#define cr_FileTransferInitResponse_size         219
-#define cr_FileTransferInit_size                 42
+#define cr_FileTransferDataNotification_size     237
+#define cr_FileTransferData_size                 236
+#define cr_FileTransferInitResponse_size         238
+#define cr_FileTransferInit_size                 55
+#define cr_LargeParameterData_size               208
+#define cr_LargeParameterRead_size               18
+#define cr_LargeParameterWriteResult_size        25
+#define cr_LargeParameterWrite_size              197
 #define cr_ParamExInfoResponse_size              208
 #define cr_ParamExKey_size                       23
-#define cr_ParameterInfoRequest_size             198
+#define cr_ParameterInfoRequest_size             235
 #define cr_ParameterInfoResponse_size            244
 #define cr_ParameterInfo_size                    120
 #define cr_ParameterNotification_size            192
-#define cr_ParameterNotifyConfigResponse_size    11
-#define cr_ParameterNotifyConfig_size            25
+#define cr_ParameterNotifyConfigList_size        175
+#define cr_ParameterNotifyConfigResponse_size    17
+#define cr_ParameterNotifyConfig_size            40
+#define cr_ParameterRange_size                   12
 #define cr_ParameterReadResult_size              198
-#define cr_ParameterRead_size                    204
+#define cr_ParameterRead_size                    241
 #define cr_ParameterValue_size                   46
 #define cr_ParameterWriteResult_size             11
-#define cr_ParameterWrite_size                   198
+#define cr_ParameterWrite_size                   200
 #define cr_PingRequest_size                      197
 #define cr_PingResponse_size                     208
 #define cr_ReachMessageHeader_size               30